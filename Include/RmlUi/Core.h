@@ -39,6 +39,7 @@
 #include "Core/ComputedValues.h"
 #include "Core/Context.h"
 #include "Core/ContextInstancer.h"
+#include "Core/DataModel.h"
 #include "Core/Decorator.h"
 #include "Core/DecoratorInstancer.h"
 #include "Core/Element.h"
@@ -69,6 +70,7 @@
 #include "Core/PropertyIdSet.h"
 #include "Core/PropertyParser.h"
 #include "Core/PropertySpecification.h"
+#include "Core/RenderCommandBuffer.h"
 #include "Core/RenderInterface.h"
 #include "Core/Spritesheet.h"
 #include "Core/StringUtilities.h"
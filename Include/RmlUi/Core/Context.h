@@ -33,6 +33,7 @@
 #include "Types.h"
 #include "Traits.h"
 #include "Input.h"
+#include "ObserverPtr.h"
 #include "ScriptInterface.h"
 
 namespace Rml {
@@ -40,6 +41,7 @@ namespace Core {
 
 class Stream;
 class ContextInstancer;
+class DataModel;
 class ElementDocument;
 class EventListener;
 class RenderInterface;
@@ -81,10 +83,26 @@ public:
 
 	/// Updates all elements in the context's documents. 
 	/// This must be called before Context::Render, but after any elements have been changed, added or removed.
+	/// When RmlUi is built with RMLUI_THREAD_SAFE_CONTEXTS, separate contexts may be updated concurrently from
+	/// different threads. Each context must only be used by one thread at a time, and no context may be rendered while
+	/// any context is being updated. The update still calls the context's render interface, to update and release
+	/// textures and to release compiled geometry, thus the render interface must be safe to call from the updating
+	/// threads. A RenderCommandBuffer is, as it records these calls for replay on the render thread. The file and system
+	/// interfaces, and a custom font engine, are also called during the update and must be safe to call concurrently.
 	bool Update();
 	/// Renders all visible elements in the context's documents.
 	bool Render();
 
+	/// Begins a batch of DOM mutations. While a batch is active, the OnChildAdd notifications and stacking context
+	/// invalidations caused by adding or removing elements in this context are deferred and de-duplicated until the batch
+	/// ends. Batches may be nested, the deferred work is performed when the outermost batch ends.
+	/// @note The batch must be ended before the next call to Update() or Render().
+	void BeginMutationBatch();
+	/// Ends a batch of DOM mutations started with BeginMutationBatch().
+	void EndMutationBatch();
+	/// Returns true if a batch of DOM mutations is currently active.
+	bool IsMutationBatchActive() const;
+
 	/// Creates a new, empty document and places it into this context.
 	/// @param[in] tag The document type to create.
 	/// @return The new document, or nullptr if no document could be created.
@@ -107,6 +125,19 @@ public:
 	/// Unloads all loaded documents.
 	void UnloadAllDocuments();
 
+	/// Creates a data model for binding values to the elements of this context's documents.
+	/// The model is bound to elements within an element with the attribute 'data-model' set to the model's name.
+	/// @param[in] name The name of the data model.
+	/// @return The new data model, or nullptr if a model with the given name already exists.
+	DataModel* CreateDataModel(const String& name);
+	/// Returns the data model with the given name.
+	/// @param[in] name The name of the data model.
+	/// @return The data model, or nullptr if no model exists with the name.
+	DataModel* GetDataModel(const String& name);
+	/// Removes and destroys a data model. Elements bound to the model keep their current values.
+	/// @param[in] name The name of the data model.
+	void RemoveDataModel(const String& name);
+
 	/// Enable or disable handling of the mouse cursor from this context.
 	/// When enabled, changes to the cursor name is transmitted through the system interface.
 	/// @param[in] show True to enable mouse cursor handling, false to disable.
@@ -161,6 +192,30 @@ public:
 	/// @param[in] in_capture_phase True to detach from the capture phase, false from the bubble phase.
 	void RemoveEventListener(const String& event, EventListener* listener, bool in_capture_phase = false);
 
+	/// Statistics of the input queue, counted since the statistics were last reset.
+	struct InputQueueStatistics {
+		// Number of input events submitted while the queue was enabled.
+		int queued_events = 0;
+		// Number of mouse moves and mouse-wheel movements merged into the preceding event of the same kind.
+		int coalesced_events = 0;
+		// Number of events processed from the queue after coalescing.
+		int processed_events = 0;
+	};
+
+	/// Enable or disable the input queue. When enabled, input events sent into this context are not processed
+	/// immediately, but queued and processed in order at the start of the next call to Update(). Consecutive mouse
+	/// moves are coalesced into the last position, and consecutive mouse-wheel movements into their total movement.
+	/// While the input queue is enabled, the input functions always return true as the events are not yet processed.
+	/// Any queued events are processed immediately when the queue is disabled.
+	/// @param[in] enable True to enable the input queue, false to disable.
+	void EnableInputQueue(bool enable);
+	/// Returns true if the input queue is enabled.
+	bool IsInputQueueEnabled() const;
+	/// Returns the statistics of the input queue.
+	const InputQueueStatistics& GetInputQueueStatistics() const;
+	/// Resets the statistics of the input queue.
+	void ResetInputQueueStatistics();
+
 	/// Sends a key down event into this context.
 	/// @param[in] key_identifier The key pressed.
 	/// @param[in] key_modifier_state The state of key modifiers (shift, control, caps-lock, etc) keys; this should be generated by ORing together members of the Input::KeyModifier enumeration.
@@ -230,8 +285,10 @@ private:
 
 	using ElementSet = SmallOrderedSet< Element* > ;
 	using ElementList = std::vector< Element* >;
-	// Set of elements that are currently in hover state.
-	ElementSet hover_chain;
+	// Elements that are currently in hover state, from the hover element towards the root. The elements are stamped with
+	// the generation of the chain, which is advanced every time the chain is rebuilt.
+	ElementList hover_chain;
+	unsigned int hover_chain_generation;
 	// List of elements that are currently in active state.
 	ElementList active_chain;
 	// History of windows that have had focus
@@ -274,29 +331,104 @@ private:
 	// The element currently being dragged over; this is equivalent to hover, but only set while an element is being
 	// dragged, and excludes the dragged element.
 	Element* drag_hover;
-	// Set of elements that are currently being dragged over; this differs from the hover state as the dragged element
-	// itself can't be part of it.
-	ElementSet drag_hover_chain;
+	// Elements that are currently being dragged over; this differs from the hover state as the dragged element
+	// itself can't be part of it. Stamped with the generation of the chain, similar to the hover chain.
+	ElementList drag_hover_chain;
+	unsigned int drag_hover_chain_generation;
+
+	// Storage reused when rebuilding the hover chains, to avoid allocating during every mouse move.
+	ElementList chain_scratch;
+	std::vector< ObserverPtr<Element> > chain_leave_scratch;
+	std::vector< ObserverPtr<Element> > chain_enter_scratch;
 
 	// Input state; stored from the most recent input events we receive from the application.
 	Vector2i mouse_position;
 
+	struct QueuedInput {
+		enum class Type { KeyDown, KeyUp, TextInput, MouseMove, MouseButtonDown, MouseButtonUp, MouseWheel };
+		Type type;
+		int key_modifier_state;
+		// The key identifier for key events, or the button index for mouse button events.
+		int index;
+		Vector2i mouse_position;
+		float wheel_delta;
+		String text;
+	};
+
+	// Input events waiting to be processed during the next update, only used when the input queue is enabled.
+	std::vector< QueuedInput > input_queue;
+	bool input_queue_enabled;
+	// True while the queued events are being processed, any events sent meanwhile are processed immediately.
+	bool processing_input_queue;
+	InputQueueStatistics input_queue_statistics;
+
+	// Storage reused for the parameters of mouse move events, to avoid allocating during every mouse move.
+	Dictionary mouse_move_parameters_scratch;
+	Dictionary drag_move_parameters_scratch;
+
+	// Nesting depth of the currently active mutation batches.
+	int mutation_batch_depth;
+	// Elements whose OnChildAdd notifications have been deferred by the active mutation batch.
+	std::vector< ObserverPtr<Element> > batch_added_elements;
+	// Elements whose stacking context invalidation has been deferred by the active mutation batch.
+	std::vector< ObserverPtr<Element> > batch_stacking_context_elements;
+
+	// Number of attached elements whose update of dirty descendants was skipped because they were not rendered.
+	int num_deferred_updates;
+
+	// Elements with running animations. Only these elements are visited when advancing animations. Entries are cleared
+	// when elements are detached, and removed after each pass. Each element stores the index of its entry.
+	std::vector< ObserverPtr<Element> > animated_elements;
+
+	// Data models bound to the elements of this context, by name.
+	UnorderedMap< String, UniquePtr<DataModel> > data_models;
+
 	// The render interface this context renders through.
 	RenderInterface* render_interface;
 	Vector2i clip_origin;
 	Vector2i clip_dimensions;
 
+	// The frame this context was last rendered in, used to count frames for the texture memory budget.
+	int texture_frame;
+
+	// Internal callback for when an element is attached to the hierarchy.
+	void OnElementAttach(Element* element);
 	// Internal callback for when an element is detached or removed from the hierarchy.
 	void OnElementDetach(Element* element);
+	// Removes the given element and its descendants from the count of deferred updates, as they are being unloaded.
+	void ReleaseDeferredUpdates(Element* element);
+
+	// Adds an element with running animations to the list of animated elements.
+	void ScheduleAnimations(Element* element);
+	// Advances the animations of all animated elements, and removes elements whose animations have all completed.
+	void AdvanceAnimations();
 	// Internal callback for when a new element gains focus.
 	bool OnFocusChange(Element* element);
 
+	// Adds an input event to the input queue if it is enabled, coalescing it with the previous event when possible.
+	// @return True if the event was queued, false if it should be processed immediately.
+	bool QueueInput(QueuedInput::Type type, int key_modifier_state, int index = 0, Vector2i position = Vector2i(0, 0), float wheel_delta = 0.f, const String& text = String());
+	// Processes all events in the input queue.
+	void ProcessInputQueue();
+
 	// Generates an event for faking clicks on an element.
 	void GenerateClickEvent(Element* element);
 
 	// Updates the current hover elements, sending required events.
 	void UpdateHoverChain(const Dictionary& parameters, const Dictionary& drag_parameters, const Vector2i& old_mouse_position);
 
+	// Rebuilds a hover chain from the given element towards the root, and sends events to the elements leaving and entering the chain.
+	// @param[in,out] chain The chain to rebuild.
+	// @param[in,out] generation The generation of the chain, advanced by this call.
+	// @param[in] element_generation The member of the elements holding their stamp for this chain.
+	// @param[in] element The new innermost element of the chain.
+	// @param[in] leave_id The event sent to elements leaving the chain.
+	// @param[in] enter_id The event sent to elements entering the chain.
+	// @param[in] parameters The parameters of the events, no events are sent if null.
+	void UpdateChain(ElementList& chain, unsigned int& generation, unsigned int Element::* element_generation, Element* element, EventId leave_id, EventId enter_id, const Dictionary* parameters);
+	// Removes all elements from a hover chain.
+	static void ClearChain(ElementList& chain, unsigned int& generation);
+
 	// Creates the drag clone from the given element. The old drag clone will be released if
 	// necessary.
 	// @param[in] element The element to clone.
@@ -316,6 +448,9 @@ private:
 	// Releases all unloaded documents pending destruction.
 	void ReleaseUnloadedDocuments();
 
+	// Performs the work deferred by the mutation batch which just ended.
+	void FlushMutationBatch();
+
 	// Sends the specified event to all elements in new_items that don't appear in old_items.
 	static void SendEvents(const ElementSet& old_items, const ElementSet& new_items, EventId id, const Dictionary& parameters);
 
@@ -323,6 +458,25 @@ private:
 	friend RMLUICORE_API Context* CreateContext(const String&, const Vector2i&, RenderInterface*);
 };
 
+
+/**
+	Keeps a batch of DOM mutations active in a context for the lifetime of the object, see Context::BeginMutationBatch().
+ */
+
+class RMLUICORE_API ScopedMutationBatch
+{
+public:
+	/// @param[in] context The context to batch mutations in. If nullptr, this object does nothing.
+	ScopedMutationBatch(Context* context);
+	~ScopedMutationBatch();
+
+	ScopedMutationBatch(const ScopedMutationBatch&) = delete;
+	ScopedMutationBatch& operator=(const ScopedMutationBatch&) = delete;
+
+private:
+	Context* context;
+};
+
 }
 }
 
@@ -33,6 +33,7 @@
 #include "Types.h"
 #include "Event.h"
 #include "ComputedValues.h"
+#include "Texture.h"
 
 namespace Rml {
 namespace Core {
@@ -130,6 +131,53 @@ RMLUICORE_API bool LoadFontFace(const String& file_name, bool fallback_face = fa
 /// @param[in] fallback_face True to use this font face for unknown characters in other font faces.
 /// @return True if the face was loaded successfully, false otherwise.
 RMLUICORE_API bool LoadFontFace(const byte* data, int data_size, const String& font_family, Style::FontStyle style, Style::FontWeight weight, bool fallback_face = false);
+/// Sets the directory where the default font engine stores rendered glyphs, so that they are loaded from disk instead
+/// of being rendered again on later runs. The cache is disabled by default. Should be called before any text is rendered.
+/// @param[in] directory The directory to store the cache files in, which must exist, or an empty string to disable the cache.
+RMLUICORE_API void SetFontCacheDirectory(const String& directory);
+/// Sets the memory budget of the default font engine for font faces added from files. Such faces are only loaded when
+/// first used. While their font data exceeds the budget, faces which have not been used for the given idle time are
+/// unloaded again, until they are needed. The default budget is 32 MB with an idle time of 30 seconds.
+/// @param[in] budget The budget for font data, in bytes.
+/// @param[in] idle_time The time in seconds a font face must be unused before it can be unloaded.
+RMLUICORE_API void SetFontMemoryBudget(size_t budget, double idle_time = 30.0);
+
+/// Enables packing of small textures into shared atlas textures, so that geometry using different images, such as image
+/// decorators and img elements, can be rendered without switching textures. Textures loaded from a source are then
+/// decoded through the given callback instead of being loaded by the render interface, and packed into the atlas if
+/// small enough. Textures which the callback fails to decode are loaded by the render interface as usual. Textures
+/// generated through callbacks, such as font textures, are never packed. Should be called before any documents are loaded.
+/// @param[in] decode_callback The function decoding a texture from its source, or an empty function to disable the atlas.
+/// @param[in] max_texture_size The maximum width and height of textures packed into the atlas.
+/// @param[in] max_page_size The maximum width and height of the atlas textures.
+RMLUICORE_API void EnableTextureAtlas(const TextureCallback& decode_callback, int max_texture_size = 64, int max_page_size = 1024);
+/// Returns the statistics of the texture atlas, such as its utilisation.
+RMLUICORE_API TextureAtlasStatistics GetTextureAtlasStatistics();
+/// Enables asynchronous loading of textures from a source, such as images of img elements and image decorators. Textures
+/// are then decoded through the given callback on a pool of worker threads, and rendered as nothing until decoded. Their
+/// elements are then updated, and a 'load' event is dispatched on them. Textures which the callback fails to decode are
+/// loaded by the render interface as usual. If the dimensions callback is set, the worker threads first read the
+/// dimensions of the requested textures through it, such as from the header of the image file, and the elements are
+/// updated so that the layout is correct while the textures are loading. Elements are only notified during the update
+/// of their own context. Both callbacks must be safe to call from several threads at once. If the texture atlas is also
+/// enabled, textures decoded by this callback are packed into the atlas. Should be called before any documents are
+/// loaded. Only available when RmlUi is built with RMLUI_ASYNC_TEXTURE_LOADING, otherwise a warning is logged.
+/// @param[in] decode_callback The function decoding a texture from its source, or an empty function to disable asynchronous loading.
+/// @param[in] num_threads The number of worker threads decoding textures.
+/// @param[in] dimensions_callback The function reading the dimensions of a texture from its source, optional.
+RMLUICORE_API void EnableAsyncTextureLoading(const TextureCallback& decode_callback, int num_threads = 2, const TextureDimensionsCallback& dimensions_callback = TextureDimensionsCallback());
+
+/// Sets the memory budget for textures. While the texture handles generated by RmlUi exceed the budget, the least
+/// recently used textures which have not been used for the given number of frames are released, and are loaded again
+/// when next used. A new frame begins when any context is rendered a second time, thus each context should be rendered
+/// once per frame. Each context only releases the textures of its own render interface. Textures are assumed to use four
+/// bytes per pixel, textures packed into the texture atlas are accounted for by their atlas pages. By default there is
+/// no budget.
+/// @param[in] budget The budget for textures, in bytes, or zero to disable the budget.
+/// @param[in] idle_frames The number of frames a texture must be unused before it can be released.
+RMLUICORE_API void SetTextureMemoryBudget(size_t budget, int idle_frames = 60);
+/// Returns the textures currently holding texture handles, with their memory usage.
+RMLUICORE_API std::vector<ResidentTexture> GetResidentTextures();
 
 /// Registers a generic RmlUi plugin.
 RMLUICORE_API void RegisterPlugin(Plugin* plugin);
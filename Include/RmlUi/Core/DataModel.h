@@ -0,0 +1,197 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUICOREDATAMODEL_H
+#define RMLUICOREDATAMODEL_H
+
+#include "Header.h"
+#include "Types.h"
+#include "Traits.h"
+#include "Variant.h"
+
+namespace Rml {
+namespace Core {
+
+class Element;
+class DataView;
+
+/**
+	A data model holds named values which are bound to the elements of a context's documents.
+
+	Values are bound from RML to elements inside an element with the 'data-model' attribute set to the name of the
+	model. The following bindings are available, where 'value' is the name of a value in the model:
+		{{value}}                   Text is replaced by the value.
+		data-attr-[name]="value"    Attribute is set to the value, or removed if not set.
+		data-class-[name]="value"   Class is set when the value is true.
+		data-style-[name]="value"   Property is set to the value, or removed if not set.
+		data-for="item : array"     Element is repeated for each item in the array. Within the repeated elements,
+		                            'item' refers to the entry of the array and 'item.member' to one of its members.
+
+	Setting a value only marks the elements bound to that exact value as dirty, they are updated during the next
+	Context::Update(). Values are applied to the elements through typed setters, no RML is parsed during updates. Style
+	bindings apply numbers and colours directly, while other values are parsed by the property's own parser.
+
+	Bindings are created when an element is first attached to the context, thus the data model should be created before
+	loading documents using it. The bindings stay with the element when it is moved within the context.
+ */
+
+class RMLUICORE_API DataModel : public NonCopyMoveable
+{
+public:
+	DataModel(const String& name);
+	~DataModel();
+
+	/// Returns the name of the data model.
+	const String& GetName() const;
+
+	/// A handle to a value in the model. Setting values through a handle avoids building and looking up their names.
+	struct ValueHandle {
+		int slot = -1;
+	};
+
+	/// Sets a value in the model, marking any bound elements dirty if the value changed.
+	/// @param[in] name The name of the value.
+	/// @param[in] value The new value.
+	void SetValue(const String& name, const Variant& value);
+	template< typename T >
+	void SetValue(const String& name, const T& value) {
+		SetValue(name, Variant(value));
+	}
+	/// Returns a value in the model.
+	/// @param[in] name The name of the value.
+	/// @return The value, or nullptr if it has not been set.
+	const Variant* GetValue(const String& name) const;
+
+	/// Sets the number of entries in an array, adding or removing elements repeated over the array as necessary.
+	/// @param[in] name The name of the array.
+	/// @param[in] size The new number of entries.
+	void SetArraySize(const String& name, int size);
+	/// Returns the number of entries in an array.
+	int GetArraySize(const String& name) const;
+
+	/// Sets the value of an array entry. Only elements bound to this entry are marked dirty.
+	/// @param[in] name The name of the array.
+	/// @param[in] index The index of the entry.
+	/// @param[in] value The new value.
+	void SetArrayValue(const String& name, int index, const Variant& value);
+	template< typename T >
+	void SetArrayValue(const String& name, int index, const T& value) {
+		SetArrayValue(name, index, Variant(value));
+	}
+	/// Sets the value of a member of an array entry. Only elements bound to this member are marked dirty.
+	/// @param[in] name The name of the array.
+	/// @param[in] index The index of the entry.
+	/// @param[in] member The name of the member in the entry.
+	/// @param[in] value The new value.
+	void SetArrayValue(const String& name, int index, const String& member, const Variant& value);
+	template< typename T >
+	void SetArrayValue(const String& name, int index, const String& member, const T& value) {
+		SetArrayValue(name, index, member, Variant(value));
+	}
+
+	/// Returns a handle to a value, it remains valid for the lifetime of the model.
+	/// @param[in] name The name of the value.
+	ValueHandle GetHandle(const String& name);
+	/// Returns a handle to an array entry, it remains valid for the lifetime of the model.
+	/// @param[in] name The name of the array.
+	/// @param[in] index The index of the entry.
+	ValueHandle GetArrayHandle(const String& name, int index);
+	/// Returns a handle to a member of an array entry, it remains valid for the lifetime of the model.
+	/// @param[in] name The name of the array.
+	/// @param[in] index The index of the entry.
+	/// @param[in] member The name of the member in the entry.
+	ValueHandle GetArrayHandle(const String& name, int index, const String& member);
+	/// Sets a value through its handle, marking any bound elements dirty if the value changed.
+	/// @param[in] handle The handle of the value.
+	/// @param[in] value The new value.
+	void SetValue(ValueHandle handle, const Variant& value);
+	template< typename T >
+	void SetValue(ValueHandle handle, const T& value) {
+		SetValue(handle, Variant(value));
+	}
+
+private:
+	using DataViewList = std::vector< DataView* >;
+
+	// The value and array size at an address, such as 'array[2].member', along with the views depending on them.
+	struct Slot {
+		String address;
+		Variant value;
+		bool has_value = false;
+		int array_size = 0;
+		DataViewList views;
+	};
+
+	// Returns true if the element has data bindings, or views created from its bindings when it was first bound.
+	static bool HasBindings(Element* element);
+	// Creates the views for the data bindings of an element the first time it is bound, and registers its views with
+	// this model. The views are owned by the element, thus they are created only once.
+	void BindElement(Element* element);
+	// Unregisters the views of an element from their model, they are registered again when the element is reattached.
+	static void UnbindElement(Element* element);
+	// Creates the views for the data binding attributes and text of an element.
+	static void CreateViews(Element* element, std::vector< UniquePtr<DataView> >& views);
+
+	// Updates all dirty views.
+	void Update();
+
+	// Returns the slot of an address, adding it if necessary. Slots are never removed.
+	int GetSlot(const String& address);
+	// Returns the slot of an address, or -1 if it has not been added.
+	int FindSlot(const String& address) const;
+	// Returns the value in a slot, or nullptr if it has not been set.
+	const Variant* GetSlotValue(int slot) const;
+	// Returns the array size in a slot.
+	int GetSlotArraySize(int slot) const;
+	// Sets the value in a slot, and dirties its views if the value changed.
+	void SetSlotValue(int slot, const Variant& value);
+	// Marks all views depending on a slot dirty.
+	void DirtySlot(int slot);
+
+	// Registers a view with this model, resolving the slots of its addresses, and marks it dirty.
+	void AddView(DataView* view);
+	// Unregisters a view from this model.
+	void RemoveView(DataView* view);
+
+	String name;
+
+	std::vector< Slot > slots;
+	UnorderedMap< String, int > slot_indices;
+
+	// Views to be updated in the next update. Views repeating elements are updated first, as they create and destroy views.
+	UnorderedSet< DataView* > dirty_views;
+	UnorderedSet< DataView* > dirty_repeat_views;
+
+	friend class Context;
+	friend class DataView;
+};
+
+}
+}
+
+#endif
@@ -93,6 +93,8 @@ private:
 	// Optimized for the common case of a single texture.
 	Texture first_texture;
 	std::vector< Texture > additional_textures;
+
+	friend class ElementDecoration;
 };
 
 }
@@ -62,6 +62,7 @@ class RenderInterface;
 class TransformState;
 class StyleSheet;
 struct ElementMeta;
+struct ElementDataViews;
 
 /**
 	A generic element in the DOM tree.
@@ -449,6 +450,11 @@ public:
 	/// Sets the markup and content of the element. All existing children will be replaced.
 	/// @param[in] rml The new content of the element.
 	void SetInnerRML(const String& rml);
+	/// Sets the markup and content of the element by reconciling it with the existing children. Children are matched
+	/// by tag and either their 'key' attribute or their position. Matched children only have their changed attributes
+	/// and text patched and keep all their cached state, keyed children are moved as necessary.
+	/// @param[in] rml The new content of the element.
+	void ReconcileInnerRML(const String& rml);
 
 	//@}
 
@@ -571,19 +577,36 @@ public:
 	virtual void ProcessDefaultAction(Event& event);
 
 	/// Return the computed values of the element's properties. These values are updated as appropriate on every Context::Update.
-	const ComputedValues& GetComputedValues() const;
+	/// Elements inside hidden documents or 'display: none' elements are not updated by the context, their values are
+	/// instead resolved here when needed.
+	const ComputedValues& GetComputedValues();
+
+	/// Marks this element as needing an update during the next context update. Elements are only visited during the
+	/// update when they, or one of their descendants, have been marked. Changes to properties, classes and structure
+	/// mark the element automatically.
+	void DirtyUpdate();
 
 protected:
-	void Update(float dp_ratio);
+	/// Updates this element and its dirty descendants.
+	/// @param[in] dp_ratio The density-independent pixel ratio of the context.
+	/// @param[in] update_hidden If false, the descendants of elements which are not rendered, that is elements with 'display: none' and hidden documents, are not updated until the elements are revealed.
+	void Update(float dp_ratio, bool update_hidden = true);
 	void Render();
 
 	/// Updates definition, computed values, and runs OnPropertyChange on this element.
-	void UpdateProperties();
+	/// @param[in] start_transitions False to apply changes to the definition without starting any transitions.
+	void UpdateProperties(bool start_transitions = true);
 
 	/// Forces the element to generate a local stacking context, regardless of the value of its z-index property.
 	void ForceLocalStackingContext();
 
-	/// Called during the update loop after children are updated.
+	/// Enables updating of this element during every context update, regardless of whether it has been changed. Must
+	/// be enabled for elements relying on OnUpdate() being called continuously.
+	/// @param[in] enable True to update the element every frame, false to only update it when dirty.
+	void EnableContinuousUpdate(bool enable);
+
+	/// Called during the update loop after children are updated. Only called when the element has been marked with
+	/// DirtyUpdate(), or every update when continuous updates are enabled.
 	virtual void OnUpdate();
 	/// Called during render after backgrounds, borders, decorators, but before children, are rendered.
 	virtual void OnRender();
@@ -605,6 +628,9 @@ protected:
 	/// Called when a child node has been removed up to two levels below us in the hierarchy.
 	/// @param[in] child The element that has been removed. This may be this element.
 	virtual void OnChildRemove(Element* child);
+	/// Called when a texture used by the element or its decorators has been loaded asynchronously, or its dimensions have
+	/// been read while loading, see Texture::AddLoadListener().
+	virtual void OnTextureLoad();
 
 	/// Forces a re-layout of this element, and any other elements required.
 	virtual void DirtyLayout();
@@ -633,6 +659,25 @@ private:
 	void DirtyStructure();
 	void UpdateStructure();
 
+	/// Patches this element to match the given element of the same tag, see ReconcileInnerRML().
+	/// @return False if this element could not be patched and must be replaced by the given element.
+	bool ReconcileElement(Element& source);
+
+	/// Patches the attributes of this element to match the given attributes.
+	/// @return False if the attributes could not be patched, in which case no changes are made.
+	bool ReconcileAttributes(const ElementAttributes& source_attributes);
+	/// Returns true if the children of this element and the given element, including non-DOM children, are equal in
+	/// tag, attributes and text, recursively.
+	bool EqualChildren(const Element& source) const;
+	/// Reconciles the DOM children of this element with the DOM children of the given element, adopting its
+	/// children where no match exists.
+	void ReconcileChildren(Element& source);
+
+	/// Calls OnChildAdd on this element and its ancestors, deferred if a mutation batch is active in the context.
+	void NotifyChildAdd();
+	/// Calls OnChildRemove on this element and its ancestors, skipped if the addition of this element was never notified.
+	void NotifyChildRemove();
+
 	void DirtyTransformState(bool perspective_dirty, bool transform_dirty);
 	void UpdateTransformState();
 
@@ -654,7 +699,28 @@ private:
 	void HandleAnimationProperty();
 
 	/// Advances the animations (including transitions) forward in time.
-	void AdvanceAnimations();
+	void AdvanceAnimations(double time);
+	/// Advances animations started since animations were last advanced, so that they apply in the same frame.
+	void AdvanceStartedAnimations();
+	/// Adds this element to the context's list of animated elements, if not already listed.
+	void ScheduleAnimations();
+	/// Applies an animated value of a property which only affects rendering, such as transform and opacity, directly to
+	/// the computed values. This avoids dirtying the property and recomputing all the values of the element.
+	/// @return True if the property was applied, false if it must be set normally.
+	bool ApplyAnimatedRenderProperty(PropertyId id, const Property& property);
+	/// Sets the computed opacity of this element and its descendants inheriting it, notifying them of the change.
+	void UpdateComputedOpacity(float opacity);
+
+	/// Updates this element and its dirty descendants, see Update().
+	/// @param[in] start_transitions False while updating descendants whose update was deferred while they were not rendered.
+	void UpdateElement(float dp_ratio, bool update_hidden, bool start_transitions);
+	/// Returns true if the descendants of this element are not rendered, regardless of their own properties.
+	bool IsSubtreeHidden() const;
+	/// Sets whether the update of the dirty descendants of this element was skipped, counting them on the context.
+	void SetDescendantUpdateDeferred(bool deferred);
+	/// Updates the properties of this element and its ancestors below the given one, whose descendants are not rendered
+	/// and thus skipped by the context update.
+	void UpdateHiddenProperties(const Element* hidden_ancestor);
 
 	// Original tag this element came from.
 	String tag;
@@ -714,6 +780,21 @@ private:
 
 	bool structure_dirty;
 
+	// Set when this element must be visited during the next update, or when any of its descendants must be.
+	bool update_dirty;
+	bool descendant_update_dirty;
+	bool continuous_update;
+	// Set when the update of dirty descendants was skipped because they were not rendered.
+	bool descendant_update_deferred;
+
+	// Set while notifications or invalidations of this element are deferred by a mutation batch in the context.
+	bool batch_child_add_pending;
+	bool batch_stacking_context_pending;
+
+	// Generation stamps set by the context while this element is part of its hover and drag hover chains, zero if never.
+	unsigned int hover_chain_generation;
+	unsigned int drag_hover_chain_generation;
+
 	bool computed_values_are_default_initialized;
 
 	// Cached rendering information
@@ -729,15 +810,24 @@ private:
 	ElementAnimationList animations;
 	bool dirty_animation;
 	bool dirty_transition;
+	// The index of this element in its context's list of animated elements, or -1 if not listed.
+	int animated_element_index;
+	// True if animations were started since they were last advanced.
+	bool animations_started;
+
+	/// Returns the views binding this element to a data model, stored in the element's meta. Used by DataModel.
+	ElementDataViews& GetDataViews();
 
 	ElementMeta* meta;
 
 	friend class Context;
+	friend class DataModel;
 	friend class ElementStyle;
 	friend class LayoutEngine;
 	friend class LayoutInlineBox;
 	friend struct ElementDeleter;
 	friend class ElementScroll;
+	friend class TextureLoader;
 };
 
 }
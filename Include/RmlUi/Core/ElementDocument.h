@@ -123,6 +123,8 @@ public:
 	/// Updates the document, including its layout. Users must call this manually before requesting information such as 
 	/// size or position of an element if any element in the document was recently changed, unless Context::Update has
 	/// already been called after the change. This has a perfomance penalty, only call when necessary.
+	/// Note: Context::Update does not resolve the styles of elements in hidden documents or inside 'display: none'
+	/// elements, nor the layout of hidden documents, until they are revealed. This function updates them regardless.
 	void UpdateDocument();
 	
 protected:
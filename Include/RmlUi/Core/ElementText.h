@@ -82,6 +82,17 @@ public:
 	/// @param[in] line The contents of the line.
 	virtual void AddLine(const Vector2f& line_position, const String& line) = 0;
 
+	/// Generates a line of text rendered from this element as code points, see GenerateLine(). By default, the line is
+	/// generated through GenerateLine() and decoded.
+	/// @param[out] line The code points making up the line.
+	/// @return True if the line reached the end of the element's text, false if not.
+	virtual bool GenerateCharacterLine(std::vector< Character >& line, int& line_length, float& line_width, int line_begin, float maximum_line_width, float right_spacing_width, bool trim_whitespace_prefix, bool decode_escape_characters);
+	/// Adds a new line given as code points into the text element, see AddLine(). By default, the line is encoded as
+	/// UTF-8 and added through AddLine().
+	/// @param[in] line_position The position of this line, as an offset from the first line.
+	/// @param[in] line The code points of the line.
+	virtual void AddCharacterLine(const Vector2f& line_position, const std::vector< Character >& line);
+
 	/// Prevents the element from dirtying its document's layout when its text is changed.
 	virtual void SuppressAutoLayout() = 0;
 };
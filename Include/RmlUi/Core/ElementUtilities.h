@@ -90,6 +90,10 @@ public:
 	/// Bind and instance all event attributes on the given element onto the element
 	/// @param element Element to bind events on
 	static void BindEventAttributes(Element* element);
+	/// Returns true if the attribute of the given name binds an event listener, see BindEventAttributes().
+	/// @param[in] name The name of the attribute.
+	/// @param[out] event_type The type of the event bound by the attribute, if any.
+	static bool IsEventAttribute(const String& name, String* event_type = nullptr);
 
 	/// Generates the clipping region for an element.
 	/// @param[out] clip_origin The origin, in context coordinates, of the origin of the element's clipping window.
@@ -131,6 +131,9 @@ private:
 	/// Release this event through its instancer.
 	void Release() override;
 
+	/// Resets the event to a newly constructed state, reusing the memory of its parameters.
+	void Initialise(Element* target, EventId id, const String& type, const Dictionary& parameters, bool interruptible);
+
 	String type;
 	EventId id = EventId::Invalid;
 	bool interruptible = false;
@@ -146,6 +149,7 @@ private:
 	EventInstancer* instancer = nullptr;
 
 	friend class Factory;
+	friend class EventInstancerDefault;
 };
 
 
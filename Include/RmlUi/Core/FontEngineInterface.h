@@ -113,6 +113,16 @@ public:
 	/// @param[in] prior_character The optionally-specified character that immediately precedes the string. This may have an impact on the string width due to kerning.
 	/// @return The width, in pixels, this string will occupy if rendered with this handle.
 	virtual int GetStringWidth(FontFaceHandle handle, const String& string, Character prior_character = Character::Null);
+	/// Called by RmlUi when it wants to retrieve the advance of each character of a string of code points, so that text
+	/// can be measured without decoding it again. Not supported by default, text is then measured a word at a time
+	/// through GetStringWidth(), which suits font engines where the width of a word is not the sum of its characters.
+	/// @param[in] handle The font handle.
+	/// @param[in] string The code points of the string to measure.
+	/// @param[in] num_characters The number of code points in the string.
+	/// @param[out] advances The advance of each character, including the kerning between it and the preceding character.
+	/// @param[in] prior_character The optionally-specified character that immediately precedes the string.
+	/// @return True if the advances were retrieved, false if not supported by the font engine.
+	virtual bool GetCharacterAdvances(FontFaceHandle handle, const Character* string, int num_characters, int* advances, Character prior_character = Character::Null);
 
 	/// Called by RmlUi when it wants to retrieve the geometry required to render a single line of text.
 	/// @param[in] face_handle The font handle.
@@ -123,12 +133,27 @@ public:
 	/// @param[out] geometry An array of geometries to generate the geometry into.
 	/// @return The width, in pixels, of the string geometry.
 	virtual int GenerateString(FontFaceHandle face_handle, FontEffectsHandle font_effects_handle, const String& string, const Vector2f& position, const Colourb& colour, GeometryList& geometry);
+	/// Called by RmlUi when it wants to retrieve the geometry required to render a single line of text given as code
+	/// points. By default, the string is encoded as UTF-8 and generated through GenerateString().
+	/// @param[in] face_handle The font handle.
+	/// @param[in] font_effects_handle The handle to the prepared font effects for which the geometry should be generated.
+	/// @param[in] string The code points of the string to render.
+	/// @param[in] num_characters The number of code points in the string.
+	/// @param[in] position The position of the baseline of the first character to render.
+	/// @param[in] colour The colour to render the text.
+	/// @param[out] geometry An array of geometries to generate the geometry into.
+	/// @return The width, in pixels, of the string geometry.
+	virtual int GenerateCharacterString(FontFaceHandle face_handle, FontEffectsHandle font_effects_handle, const Character* string, int num_characters, const Vector2f& position, const Colourb& colour, GeometryList& geometry);
 
 	/// Called by RmlUi to determine if the text geometry is required to be re-generated. Whenever the returned version
 	/// is changed, all geometry belonging to the given face handle will be re-generated.
 	/// @param[in] face_handle The font handle.
 	/// @return The version required for using any geometry generated with the face handle.
 	virtual int GetVersion(FontFaceHandle handle);
+
+	/// Called by RmlUi during the update of each context, even when nothing is rendered or laid out. Allows the font
+	/// engine to release font data which has not been used for a while.
+	virtual void ReleaseIdleResources();
 };
 
 }
@@ -94,6 +94,10 @@ private:
 	// Returns the host context's render interface.
 	RenderInterface* GetRenderInterface();
 
+	// Returns the vertices to render, remapped to the texture's region on its atlas page if it is packed into an atlas,
+	// along with the handle to render them with.
+	const std::vector< Vertex >& UpdateAtlasVertices(RenderInterface* render_interface, TextureHandle& handle);
+
 	Context* host_context = nullptr;
 	Element* host_element = nullptr;
 
@@ -101,7 +105,14 @@ private:
 	std::vector< int > indices;
 	const Texture* texture = nullptr;
 
+	// Vertices with their texture coordinates transformed into the texture's region on its atlas page, and the version
+	// of the atlas layout they were transformed for.
+	std::vector< Vertex > atlas_vertices;
+	int atlas_version = -1;
+
 	CompiledGeometryHandle compiled_geometry = 0;
+	// The texture handle the geometry was compiled with.
+	TextureHandle compiled_texture_handle = 0;
 	bool compile_attempted = false;
 
 	GeometryDatabaseHandle database_handle;
@@ -98,6 +98,11 @@ public:
     /** removes 'res' number of items from the stack
     @param[in] res Number of results to remove from the stack.   */
     static void EndCall(int res = 0);
+
+    /** Returns the number of inline event handlers (such as onclick="...") compiled so far. Handlers are
+    compiled once per code string, listeners with identical code share the compiled function.
+    @return The number of compiled event handlers.    */
+    static int GetEventListenerCompileCount();
     
 private:
     int GetEventClasses() override;
@@ -67,6 +67,14 @@ void LuaType<T>::Register(lua_State* L)
     lua_pushcfunction(L, tostring_T);
     lua_setfield(L, metatable, "__tostring");
 
+    //weak table of the userdata pushed for objects not owned by Lua, so that they are reused while still referenced
+    lua_newtable(L); //->[3] = cache table
+    lua_newtable(L); //->[4] = metatable for the cache
+    lua_pushstring(L, "v");
+    lua_setfield(L, -2, "__mode"); //[4].__mode = "v"
+    lua_setmetatable(L, -2); //[3]'s metatable = [4]; pop [4]
+    lua_setfield(L, metatable, "__cache"); //[metatable = 2].__cache = [3]; pop [3]
+
     ExtraInit<T>(L,metatable); //optionally implemented by individual types
 
     lua_newtable(L); //for method table -> [3] = this table
@@ -86,40 +94,58 @@ int LuaType<T>::push(lua_State *L, T* obj, bool gc)
     luaL_getmetatable(L, GetTClassName<T>());  // lookup metatable in Lua registry ->[1] = metatable of <ClassName>
     if (lua_isnil(L, -1)) luaL_error(L, "%s missing metatable", GetTClassName<T>());
     int mt = lua_gettop(L); //mt = 1
-    T** ptrHold = (T**)lua_newuserdata(L,sizeof(T**)); //->[2] = empty userdata
-    int ud = lua_gettop(L); //ud = 2
-    if(ptrHold != nullptr)
+    lua_getfield(L, mt, "__cache"); //->[2] = weak table of userdata by object, see Register
+    int cache = lua_gettop(L); //cache = 2
+    bool use_cache = (gc == false && lua_istable(L, cache));
+    if(use_cache)
     {
-        *ptrHold = obj; 
-        lua_pushvalue(L, mt); // ->[3] = copy of [1]
-        lua_setmetatable(L, -2); //[-2 = 2] -> [2]'s metatable = [3]; pop [3]
-        char name[max_pointer_string_size];
-        tostring(name, max_pointer_string_size, obj);
-        lua_getfield(L,LUA_REGISTRYINDEX,"DO NOT TRASH"); //->[3] = value returned from function
-        if(lua_isnil(L,-1) ) //if [3] hasn't been created yet, then create it
-        {
-            luaL_newmetatable(L,"DO NOT TRASH"); //[4] = the new metatable
-            lua_pop(L,1); //pop [4]
-        }
-        lua_pop(L,1); //pop [3]
-        lua_getfield(L,LUA_REGISTRYINDEX,"DO NOT TRASH"); //->[3] = value returned from function
-        if(gc == false) //if we shouldn't garbage collect it, then put the name in to [3]
-        {
-            lua_pushboolean(L,1);// ->[4] = true
-            lua_setfield(L,-2,name); //represents t[k] = v, [-2 = 3] = t -> v = [4], k = <ClassName>; pop [4]
-        }
-        else
+        //objects not owned by Lua reuse the userdata from a previous push while it is still alive
+        lua_pushlightuserdata(L, obj);
+        lua_rawget(L, cache); //->[3] = cached userdata, or nil
+        if(lua_isnil(L, -1))
+            lua_pop(L, 1); //pop [3]
+    }
+    if(lua_gettop(L) == cache)
+    {
+        T** ptrHold = (T**)lua_newuserdata(L,sizeof(T**)); //->[3] = empty userdata, raises an error on failure
+        *ptrHold = obj;
+        lua_pushvalue(L, mt); // ->[4] = copy of [1]
+        lua_setmetatable(L, -2); //[-2 = 3] -> [3]'s metatable = [4]; pop [4]
+        if(use_cache)
         {
-            //In case this is an address that has been pushed
-            //to lua before, we need to set it to nil
-            lua_pushnil(L); // ->[4] = nil
-            lua_setfield(L,-2,name); //represents t[k] = v, [-2 = 3] = t -> v = [4], k = <ClassName>; pop [4]
+            lua_pushlightuserdata(L, obj); // ->[4] = key
+            lua_pushvalue(L, -2); // ->[5] = copy of [3]
+            lua_rawset(L, cache); //[cache = 2] -> t[k] = v; pop [4] and [5]
         }
+    }
+    int ud = lua_gettop(L); //ud = 3
 
-        lua_pop(L,1); // -> pop [3]
+    char name[max_pointer_string_size];
+    tostring(name, max_pointer_string_size, obj);
+    lua_getfield(L,LUA_REGISTRYINDEX,"DO NOT TRASH"); //->[4] = value returned from function
+    if(lua_isnil(L,-1) ) //if [4] hasn't been created yet, then create it
+    {
+        luaL_newmetatable(L,"DO NOT TRASH"); //[5] = the new metatable
+        lua_pop(L,1); //pop [5]
+    }
+    lua_pop(L,1); //pop [4]
+    lua_getfield(L,LUA_REGISTRYINDEX,"DO NOT TRASH"); //->[4] = value returned from function
+    if(gc == false) //if we shouldn't garbage collect it, then put the name in to [4]
+    {
+        lua_pushboolean(L,1);// ->[5] = true
+        lua_setfield(L,-2,name); //represents t[k] = v, [-2 = 4] = t -> v = [5], k = <ClassName>; pop [5]
     }
-    lua_settop(L,ud); //[ud = 2] -> remove everything that is above 2, top = [2]
-    lua_replace(L, mt); //[mt = 1] -> move [2] to pos [1], and pop previous [1]
+    else
+    {
+        //In case this is an address that has been pushed
+        //to lua before, we need to set it to nil
+        lua_pushnil(L); // ->[5] = nil
+        lua_setfield(L,-2,name); //represents t[k] = v, [-2 = 4] = t -> v = [5], k = <ClassName>; pop [5]
+    }
+    lua_pop(L,1); // -> pop [4]
+
+    lua_settop(L,ud); //[ud = 3] -> remove everything that is above 3, top = [3]
+    lua_replace(L, mt); //[mt = 1] -> move [3] to pos [1], and pop previous [1]
     lua_settop(L, mt); //remove everything above [1]
     return mt;  // index of userdata containing pointer to T object
 }
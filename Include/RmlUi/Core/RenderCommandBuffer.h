@@ -0,0 +1,187 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUICORERENDERCOMMANDBUFFER_H
+#define RMLUICORERENDERCOMMANDBUFFER_H
+
+#include "Header.h"
+#include "RenderInterface.h"
+#include "Types.h"
+
+namespace Rml {
+namespace Core {
+
+/**
+	A render interface which records the render calls of contexts into a command buffer, instead of rendering
+	immediately. The recorded commands can later be replayed through the application's render interface, possibly on a
+	separate render thread.
+
+	Install the command buffer as the render interface of one or more contexts. After calling Context::Render(), call
+	Submit() to publish the recorded commands. The render thread then calls Replay() to execute them. The command buffer
+	is double-buffered: one buffer is recorded while the other is replayed, and Submit() waits until the previously
+	submitted buffer has been replayed.
+
+	Geometry data is copied into the buffer, so the commands remain valid after the elements have changed. Compiled
+	geometry and textures are returned as handles owned by the command buffer, which are resolved to the handles of the
+	application's render interface during replay. Thus, the application's render interface is only ever called from the
+	thread replaying the commands. Compiling geometry, as well as generating, updating and releasing textures, are
+	recorded in order with the other commands, so that resources are only released after all earlier commands
+	referencing them have been replayed.
+
+	Loading a texture from a source requires its dimensions right away. If a dimensions callback is provided, the
+	dimensions are read through it, and loading the texture is recorded like the other commands. Otherwise, loading is
+	forwarded to the application's render interface immediately, which must then be safe to call from the thread
+	rendering the contexts.
+
+	Texture updates are recorded with a copy of the updated region. If the application's render interface fails to
+	update a texture during replay, all textures of the command buffer are released on the next submit so that they are
+	generated again, and further updates are no longer recorded.
+
+	Contexts also call the render interface during Context::Update(), such as to update textures and to release
+	compiled geometry. When built with RMLUI_THREAD_SAFE_CONTEXTS, recording is guarded by a mutex, so that contexts
+	sharing the command buffer can be updated concurrently from separate threads, while only the render thread calls
+	the application's render interface. Loading textures without a dimensions callback is the exception, as it calls the
+	application's render interface from the updating thread.
+ */
+
+class RMLUICORE_API RenderCommandBuffer : public RenderInterface
+{
+public:
+	/// Constructs a command buffer replaying through the given render interface.
+	/// @param[in] render_interface The application's render interface, used during replay.
+	/// @param[in] dimensions_callback The function reading the dimensions of a texture from its source, such as from the
+	///     header of the image file, so that loading textures can be recorded. Optional, see the class description.
+	RenderCommandBuffer(RenderInterface* render_interface, const TextureDimensionsCallback& dimensions_callback = TextureDimensionsCallback());
+	/// Releases any geometry and textures created during replay. Should be destroyed on the render thread after the
+	/// contexts using it, and after the final commands have been submitted and replayed.
+	virtual ~RenderCommandBuffer();
+
+	/// Publishes the commands recorded since the last submit for replay. Blocks until the previously submitted commands
+	/// have been replayed.
+	void Submit();
+	/// Replays the most recently submitted commands through the application's render interface.
+	/// @return True if any commands were replayed, false if nothing has been submitted since the last replay.
+	bool Replay();
+
+	void RenderGeometry(Vertex* vertices, int num_vertices, int* indices, int num_indices, TextureHandle texture, const Vector2f& translation) override;
+	CompiledGeometryHandle CompileGeometry(Vertex* vertices, int num_vertices, int* indices, int num_indices, TextureHandle texture) override;
+	void RenderCompiledGeometry(CompiledGeometryHandle geometry, const Vector2f& translation) override;
+	void ReleaseCompiledGeometry(CompiledGeometryHandle geometry) override;
+
+	void EnableScissorRegion(bool enable) override;
+	void SetScissorRegion(int x, int y, int width, int height) override;
+
+	bool LoadTexture(TextureHandle& texture_handle, Vector2i& texture_dimensions, const String& source) override;
+	bool GenerateTexture(TextureHandle& texture_handle, const byte* source, const Vector2i& source_dimensions) override;
+	bool UpdateTexture(TextureHandle texture_handle, const Vector2i& region_offset, const Vector2i& region_dimensions, const byte* source, int source_stride) override;
+	void ReleaseTexture(TextureHandle texture) override;
+
+	void SetTransform(const Matrix4f* transform) override;
+
+private:
+	enum class CommandType { SetContext, RenderGeometry, CompileGeometry, RenderCompiledGeometry, ReleaseCompiledGeometry, EnableScissorRegion, SetScissorRegion, SetTransform, LoadTexture, AddLoadedTexture, GenerateTexture, UpdateTexture, ReleaseTexture };
+
+	struct Command {
+		CommandType type = CommandType::SetContext;
+		// Ranges into the vertices and indices of the buffer, or the scissor region. For textures, the offset into the
+		// texture data or the index into the texture sources, and the dimensions of the texture data.
+		int offset[2] = {};
+		int size[2] = {};
+		TextureHandle texture = 0;
+		// The application's handle of a texture loaded while recording.
+		TextureHandle loaded_texture = 0;
+		// The offset of the updated region within the texture.
+		Vector2i region_offset = Vector2i(0, 0);
+		CompiledGeometryHandle geometry = 0;
+		Vector2f translation = Vector2f(0, 0);
+		// Index into the transforms of the buffer, or -1 for no transform.
+		int transform = -1;
+		Context* context = nullptr;
+	};
+
+	struct Buffer {
+		std::vector< Command > commands;
+		std::vector< Vertex > vertices;
+		std::vector< int > indices;
+		std::vector< Matrix4f > transforms;
+		std::vector< byte > texture_data;
+		StringList texture_sources;
+	};
+
+	struct CompiledGeometry {
+		// The handle returned by the application, or zero if compilation failed.
+		CompiledGeometryHandle handle;
+		// Kept to render the geometry immediately if compilation failed.
+		std::vector< Vertex > vertices;
+		std::vector< int > indices;
+		TextureHandle texture;
+	};
+
+	// Guards the submitted state, and signals when the submitted buffer has been replayed.
+	struct Synchronization;
+
+	// Adds a new command to the buffer being recorded, with the current context recorded first if it changed.
+	Command& AddCommand(CommandType type);
+	// Copies geometry data into the buffer being recorded.
+	void AddGeometry(Command& command, const Vertex* vertices, int num_vertices, const int* indices, int num_indices);
+	// Executes a single command through the application's render interface.
+	void ExecuteCommand(const Buffer& buffer, const Command& command);
+	// Returns the application's handle of a texture handle given out while recording, or zero if it has none.
+	TextureHandle GetTexture(TextureHandle texture) const;
+
+	RenderInterface* render_interface;
+	TextureDimensionsCallback dimensions_callback;
+
+	Buffer buffers[2];
+	int recording_buffer;
+	Context* recording_context;
+
+	// The last handles given out for compiled geometry and textures, only accessed while recording.
+	CompiledGeometryHandle last_geometry_handle;
+	TextureHandle last_texture_handle;
+	// The geometry compiled and the textures created during replay, indexed by the handles given out while recording.
+	UnorderedMap< CompiledGeometryHandle, CompiledGeometry > compiled_geometry;
+	UnorderedMap< TextureHandle, TextureHandle > textures;
+
+	// Set while destroying the command buffer, textures are then released immediately.
+	bool destroying;
+
+	// Cleared when the application's render interface failed to update a texture, only accessed while recording.
+	bool update_textures;
+	// Set during replay when updating a texture failed, read while submitting once the replay has completed.
+	bool update_texture_failed;
+
+	// Set when the buffer not being recorded has been submitted and is waiting for replay.
+	bool submitted;
+	UniquePtr< Synchronization > synchronization;
+};
+
+}
+}
+
+#endif
@@ -103,6 +103,16 @@ public:
 	/// @param[in] source_dimensions The dimensions, in pixels, of the source data.
 	/// @return True if the texture generation succeeded and the handle is valid, false if not.
 	virtual bool GenerateTexture(TextureHandle& texture_handle, const byte* source, const Vector2i& source_dimensions);
+	/// Called by RmlUi when a region of a texture generated by GenerateTexture() is to be replaced by new pixels.
+	/// If not supported, do not override the function or return false; the texture is then released and generated
+	/// again in full.
+	/// @param[in] texture_handle The handle of the texture to update.
+	/// @param[in] region_offset The position, in pixels, of the top-left corner of the region within the texture.
+	/// @param[in] region_dimensions The dimensions, in pixels, of the region.
+	/// @param[in] source The raw 8-bit data of the region's top-left pixel, in the same format as in GenerateTexture().
+	/// @param[in] source_stride The number of bytes between the start of each row of the source data.
+	/// @return True if the texture was updated, false if not.
+	virtual bool UpdateTexture(TextureHandle texture_handle, const Vector2i& region_offset, const Vector2i& region_dimensions, const byte* source, int source_stride);
 	/// Called by RmlUi when a loaded texture is no longer required.
 	/// @param texture The texture handle to release.
 	virtual void ReleaseTexture(TextureHandle texture);
@@ -121,6 +131,7 @@ private:
 	Context* context;
 
 	friend class Context;
+	friend class RenderCommandBuffer;
 };
 
 }
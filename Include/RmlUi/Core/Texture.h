@@ -38,6 +38,7 @@ namespace Core {
 
 class TextureResource;
 class RenderInterface;
+class Element;
 
 /*
 	Callback function for generating textures.
@@ -48,6 +49,48 @@ class RenderInterface;
 */
 using TextureCallback = std::function<bool(const String& name, UniquePtr<const byte[]>& data, Vector2i& dimensions)>;
 
+/*
+	Callback function for reading the dimensions of a texture without decoding it, such as from the header of an image file.
+	/// @param[in] source The source of the texture.
+	/// @param[out] dimensions The width and height of the texture.
+	/// @return True on success.
+*/
+using TextureDimensionsCallback = std::function<bool(const String& source, Vector2i& dimensions)>;
+
+/**
+	Statistics of the texture atlas, see Rml::Core::EnableTextureAtlas().
+ */
+struct TextureAtlasStatistics
+{
+	/// The number of textures packed into the atlas.
+	int num_textures = 0;
+	/// The number of atlas pages.
+	int num_pages = 0;
+	/// The number of pixels covered by the packed textures.
+	int used_pixels = 0;
+	/// The total number of pixels of the atlas pages.
+	int page_pixels = 0;
+
+	/// Returns the fraction of the atlas pages covered by textures.
+	float GetUtilisation() const { return page_pixels > 0 ? float(used_pixels) / float(page_pixels) : 0.f; }
+};
+
+/**
+	A texture currently holding texture handles, see Rml::Core::GetResidentTextures().
+ */
+struct ResidentTexture
+{
+	/// The source of the texture, or the name of textures generated through callback functions.
+	String source;
+	/// The dimensions of the texture.
+	Vector2i dimensions;
+	/// The memory used by the texture's handles, assuming four bytes per pixel.
+	size_t memory_size = 0;
+	/// The number of frames since the texture was last used.
+	int idle_frames = 0;
+};
+
+
 
 /**
 	Abstraction of a two-dimensional texture image, with an application-specific texture handle.
@@ -68,6 +111,16 @@ public:
 	/// @param[in] callback The callback function which generates the data of the texture, see TextureCallback.
 	void Set(const String& name, const TextureCallback& callback);
 
+	/// Updates a region of a texture set with a callback function, in every render interface that has already generated
+	/// it. Render interfaces which do not support updating textures release the texture instead, it is then generated
+	/// again through the callback function on next use, which must thus return the updated data from now on.
+	/// @param[in] region_offset The position, in pixels, of the top-left corner of the region within the texture.
+	/// @param[in] region_dimensions The dimensions, in pixels, of the region.
+	/// @param[in] source The raw 8-bit data of the region's top-left pixel, in the format of the callback function's data.
+	/// @param[in] source_stride The number of bytes between the start of each row of the source data.
+	/// @return True if the texture kept its handles, false if any of them were released.
+	bool Update(const Vector2i& region_offset, const Vector2i& region_dimensions, const byte* source, int source_stride);
+
 	/// Returns the texture's source name. This is usually the name of the file the texture was loaded from.
 	/// @return The name of the this texture's source. This will be the empty string if this texture is not loaded.
 	const String& GetSource() const;
@@ -79,6 +132,24 @@ public:
 	/// @param[in] The render interface that is requesting the dimensions.
 	/// @return The texture's dimensions. This will be (0, 0) if the texture isn't loaded.
 	Vector2i GetDimensions(RenderInterface* render_interface) const;
+	/// Returns the region of the texture's handle occupied by this texture, if the texture is packed into a texture atlas.
+	/// Texture coordinates of geometry using the texture must then be transformed into this region.
+	/// @param[in] The render interface that is requesting the region.
+	/// @param[out] texcoord_offset The texture coordinates of the texture's top-left corner on its atlas page.
+	/// @param[out] texcoord_scale The size of the texture on its atlas page, in texture coordinates.
+	/// @param[out] version The version of the texture's region, changed whenever the region moves on its page.
+	/// @param[out] handle The handle of the atlas page containing the texture.
+	/// @return True if the texture is packed into an atlas, false if its handle refers to this texture alone.
+	bool GetAtlasRegion(RenderInterface* render_interface, Vector2f& texcoord_offset, Vector2f& texcoord_scale, int& version, TextureHandle& handle) const;
+
+	/// Returns true if the texture is being loaded asynchronously, see Rml::Core::EnableAsyncTextureLoading(). Its handle
+	/// is then empty until loaded, and its dimensions are only known if they could be read in advance.
+	/// @param[in] The render interface that is requesting the texture.
+	bool IsLoading(RenderInterface* render_interface) const;
+	/// Notifies an element once the texture has been loaded asynchronously, if it is being loaded. The element's
+	/// decorators and layout are then updated, and a 'load' event is dispatched on it.
+	/// @param[in] element The element using the texture.
+	void AddLoadListener(Element* element) const;
 
 	/// Returns true if the texture points to the same underlying resource.
 	bool operator==(const Texture&) const;
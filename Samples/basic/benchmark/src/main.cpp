@@ -92,7 +92,17 @@ public:
 		}
 
 		if (auto el = document->GetElementById("performance"))
-			el->SetInnerRML(rml);
+		{
+			if (reconcile)
+				el->ReconcileInnerRML(rml);
+			else
+				el->SetInnerRML(rml);
+		}
+	}
+
+	void ToggleReconcile()
+	{
+		reconcile = !reconcile;
 	}
 
 	class SimpleEventListener : public Rml::Core::EventListener {
@@ -117,6 +127,7 @@ public:
 
 private:
 	Rml::Core::ElementDocument *document;
+	bool reconcile = false;
 };
 
 
@@ -213,6 +224,10 @@ public:
 			{
 				run_update = !run_update;
 			}
+			else if (key_identifier == Rml::Core::Input::KI_R)
+			{
+				window->ToggleReconcile();
+			}
 			else if (key_identifier == Rml::Core::Input::KI_ESCAPE)
 			{
 				Shell::RequestExit();
@@ -36,6 +36,9 @@
 ElementGame::ElementGame(const Rml::Core::String& tag) : Rml::Core::Element(tag)
 {
 	game = new Game();
+
+	// The game is advanced every frame during the update.
+	EnableContinuousUpdate(true);
 }
 
 ElementGame::~ElementGame()
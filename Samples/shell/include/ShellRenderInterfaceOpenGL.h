@@ -62,6 +62,8 @@ public:
 	bool LoadTexture(Rml::Core::TextureHandle& texture_handle, Rml::Core::Vector2i& texture_dimensions, const Rml::Core::String& source) override;
 	/// Called by RmlUi when a texture is required to be built from an internally-generated sequence of pixels.
 	bool GenerateTexture(Rml::Core::TextureHandle& texture_handle, const Rml::Core::byte* source, const Rml::Core::Vector2i& source_dimensions) override;
+	/// Called by RmlUi when a region of a generated texture is to be replaced by new pixels.
+	bool UpdateTexture(Rml::Core::TextureHandle texture_handle, const Rml::Core::Vector2i& region_offset, const Rml::Core::Vector2i& region_dimensions, const Rml::Core::byte* source, int source_stride) override;
 	/// Called by RmlUi when a loaded texture is no longer required.
 	void ReleaseTexture(Rml::Core::TextureHandle texture_handle) override;
 
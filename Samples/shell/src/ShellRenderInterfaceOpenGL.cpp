@@ -277,6 +277,21 @@ bool ShellRenderInterfaceOpenGL::GenerateTexture(Rml::Core::TextureHandle& textu
 	return true;
 }
 
+// Called by RmlUi when a region of a generated texture is to be replaced by new pixels.
+bool ShellRenderInterfaceOpenGL::UpdateTexture(Rml::Core::TextureHandle texture_handle, const Rml::Core::Vector2i& region_offset, const Rml::Core::Vector2i& region_dimensions, const Rml::Core::byte* source, int source_stride)
+{
+	if (source_stride % 4 != 0)
+		return false;
+
+	glBindTexture(GL_TEXTURE_2D, (GLuint) texture_handle);
+
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, source_stride / 4);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, region_offset.x, region_offset.y, region_dimensions.x, region_dimensions.y, GL_RGBA, GL_UNSIGNED_BYTE, source);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+	return true;
+}
+
 // Called by RmlUi when a loaded texture is no longer required.		
 void ShellRenderInterfaceOpenGL::ReleaseTexture(Rml::Core::TextureHandle texture_handle)
 {
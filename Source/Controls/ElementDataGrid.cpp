@@ -67,6 +67,9 @@ ElementDataGrid::ElementDataGrid(const Rml::Core::String& tag) : Core::Element(t
 	SetProperty(Core::PropertyId::OverflowY, Core::Property(Core::Style::Overflow::Auto));
 
 	new_data_source = "";
+
+	// Rows are created from the data source during the update.
+	EnableContinuousUpdate(true);
 }
 
 ElementDataGrid::~ElementDataGrid()
@@ -45,6 +45,9 @@ ElementFormControlInput::ElementFormControlInput(const Rml::Core::String& tag) :
 	// creating the default InputTypeText here may result in it being destroyed in just a few moments.
 	// Instead, we create the InputTypeText in OnAttributeChange in the case where the type attribute has not been set.
 	type = nullptr;
+
+	// The input types need to be updated continuously for the cursor blink and the slider arrow repeats.
+	EnableContinuousUpdate(true);
 }
 
 ElementFormControlInput::~ElementFormControlInput()
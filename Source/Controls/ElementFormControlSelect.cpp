@@ -39,6 +39,9 @@ namespace Controls {
 ElementFormControlSelect::ElementFormControlSelect(const Rml::Core::String& tag) : ElementFormControl(tag)
 {
 	widget = new WidgetDropDown(this);
+
+	// The drop-down widget rebuilds its options during the update.
+	EnableContinuousUpdate(true);
 }
 
 ElementFormControlSelect::~ElementFormControlSelect()
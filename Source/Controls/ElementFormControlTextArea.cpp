@@ -44,6 +44,9 @@ ElementFormControlTextArea::ElementFormControlTextArea(const Rml::Core::String&
 	SetProperty(Core::PropertyId::OverflowX, Core::Property(Core::Style::Overflow::Auto));
 	SetProperty(Core::PropertyId::OverflowY, Core::Property(Core::Style::Overflow::Auto));
 	SetProperty(Core::PropertyId::WhiteSpace, Core::Property(Core::Style::WhiteSpace::Prewrap));
+
+	// Updated continuously for the cursor blink.
+	EnableContinuousUpdate(true);
 }
 
 ElementFormControlTextArea::~ElementFormControlTextArea()
@@ -29,17 +29,22 @@
 #include "../../Include/RmlUi/Core/Context.h"
 #include "../../Include/RmlUi/Core/ContextInstancer.h"
 #include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/DataModel.h"
 #include "../../Include/RmlUi/Core/ElementDocument.h"
 #include "../../Include/RmlUi/Core/ElementUtilities.h"
 #include "../../Include/RmlUi/Core/Factory.h"
+#include "../../Include/RmlUi/Core/FontEngineInterface.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/RenderInterface.h"
 #include "../../Include/RmlUi/Core/StreamMemory.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "Clock.h"
 #include "EventDispatcher.h"
 #include "EventIterators.h"
 #include "PluginRegistry.h"
 #include "StreamFile.h"
+#include "TextureDatabase.h"
+#include "TextureLoader.h"
 #include <algorithm>
 #include <iterator>
 
@@ -50,7 +55,14 @@ namespace Core {
 static constexpr float DOUBLE_CLICK_TIME = 0.5f;     // [s]
 static constexpr float DOUBLE_CLICK_MAX_DIST = 3.f;  // [dp]
 
-Context::Context(const String& name) : name(name), dimensions(0, 0), density_independent_pixel_ratio(1.0f), mouse_position(0, 0), clip_origin(-1, -1), clip_dimensions(-1, -1)
+// Advances a chain generation, skipping zero which is reserved for elements that are not part of the chain.
+static inline unsigned int NextChainGeneration(unsigned int generation)
+{
+	generation += 1;
+	return generation == 0 ? 1 : generation;
+}
+
+Context::Context(const String& name) : name(name), dimensions(0, 0), density_independent_pixel_ratio(1.0f), mouse_position(0, 0), input_queue_enabled(false), processing_input_queue(false), mutation_batch_depth(0), num_deferred_updates(0), clip_origin(-1, -1), clip_dimensions(-1, -1), texture_frame(-1)
 {
 	instancer = nullptr;
 
@@ -82,6 +94,10 @@ Context::Context(const String& name) : name(name), dimensions(0, 0), density_ind
 	drag_clone = nullptr;
 	drag_hover = nullptr;
 
+	// Elements are stamped with zero while they are not part of any chain, thus the chains start at the first generation.
+	hover_chain_generation = 1;
+	drag_hover_chain_generation = 1;
+
 	last_click_element = nullptr;
 	last_click_time = 0;
 	last_click_mouse_position = Vector2i(0, 0);
@@ -99,6 +115,10 @@ Context::~Context()
 
 	root.reset();
 
+	data_models.clear();
+
+	TextureLoader::RemoveListeners(this);
+
 	instancer = nullptr;
 
 	render_interface = nullptr;
@@ -166,15 +186,36 @@ float Context::GetDensityIndependentPixelRatio() const
 bool Context::Update()
 {
 	RMLUI_ZoneScoped;
+	RMLUI_ASSERTMSG(mutation_batch_depth == 0, "Context::Update called while a mutation batch is active.");
+
+	// Process the queued input first, so that its effects are reflected in this update.
+	ProcessInputQueue();
 
-	root->Update(density_independent_pixel_ratio);
+	// Notify the elements of this context about textures loaded asynchronously, so that their layout and decorators are updated.
+	TextureLoader::ProcessCompleted(this);
+
+	// Let the font engine release font data which has gone idle, also while the document is static.
+	GetFontEngineInterface()->ReleaseIdleResources();
+
+	// Apply dirty data model values before the elements are updated.
+	for (auto& pair : data_models)
+		pair.second->Update();
+
+	AdvanceAnimations();
+
+	// Styles of hidden documents and elements with 'display: none' are resolved once they are revealed, or when their
+	// document is updated explicitly.
+	root->Update(density_independent_pixel_ratio, false);
 
 	for (int i = 0; i < root->GetNumChildren(); ++i)
-		if (auto doc = root->GetChild(i)->GetOwnerDocument())
+	{
+		auto doc = root->GetChild(i)->GetOwnerDocument();
+		if (doc && doc->IsVisible())
 		{
 			doc->UpdateLayout();
 			doc->UpdatePosition();
 		}
+	}
 
 	// Release any documents that were unloaded during the update.
 	ReleaseUnloadedDocuments();
@@ -191,6 +232,10 @@ bool Context::Render()
 	if (render_interface == nullptr)
 		return false;
 
+	// Count the frame and release the least recently used textures while over the texture memory budget, before any
+	// textures are used by this context.
+	TextureDatabase::BeginContextRender(render_interface, texture_frame);
+
 	render_interface->context = this;
 	ElementUtilities::ApplyActiveClipRegion(this, render_interface);
 
@@ -213,6 +258,28 @@ bool Context::Render()
 	return true;
 }
 
+void Context::BeginMutationBatch()
+{
+	mutation_batch_depth += 1;
+}
+
+void Context::EndMutationBatch()
+{
+	RMLUI_ASSERTMSG(mutation_batch_depth > 0, "Context::EndMutationBatch called without a matching BeginMutationBatch.");
+	if (mutation_batch_depth <= 0)
+		return;
+
+	mutation_batch_depth -= 1;
+
+	if (mutation_batch_depth == 0)
+		FlushMutationBatch();
+}
+
+bool Context::IsMutationBatchActive() const
+{
+	return mutation_batch_depth > 0;
+}
+
 // Creates a new, empty document and places it into this context.
 ElementDocument* Context::CreateDocument(const String& tag)
 {
@@ -266,6 +333,9 @@ ElementDocument* Context::LoadDocument(Stream* stream)
 
 	ElementUtilities::BindEventAttributes(document);
 
+	// The document's descendants were bound while being instanced, the document itself is never attached.
+	OnElementAttach(document);
+
 	// The 'load' event is fired before updating the document, because the user might
 	// need to initalize things before running an update. The drawback is that computed
 	// values and layouting are not performed yet, resulting in default values when
@@ -309,7 +379,9 @@ void Context::UnloadDocument(ElementDocument* _document)
 		document->DispatchEvent(EventId::Unload, Dictionary());
 		PluginRegistry::NotifyDocumentUnload(document);
 
-		// Move document to a temporary location to be released later.
+		// Move document to a temporary location to be released later. It is never detached, thus its elements are
+		// removed from the count of deferred updates here.
+		ReleaseDeferredUpdates(document);
 		unloaded_documents.push_back( root->RemoveChild(document) );
 	}
 
@@ -346,6 +418,33 @@ void Context::UnloadDocument(ElementDocument* _document)
 	UpdateHoverChain(Dictionary(), Dictionary(), mouse_position);
 }
 
+DataModel* Context::CreateDataModel(const String& name)
+{
+	if (data_models.find(name) != data_models.end())
+	{
+		Log::Message(Log::LT_WARNING, "Data model '%s' already exists in context '%s'.", name.c_str(), this->name.c_str());
+		return nullptr;
+	}
+
+	DataModel* data_model = new DataModel(name);
+	data_models[name] = UniquePtr<DataModel>(data_model);
+	return data_model;
+}
+
+DataModel* Context::GetDataModel(const String& name)
+{
+	auto it = data_models.find(name);
+	if (it == data_models.end())
+		return nullptr;
+
+	return it->second.get();
+}
+
+void Context::RemoveDataModel(const String& name)
+{
+	data_models.erase(name);
+}
+
 // Unload all the currently loaded documents
 void Context::UnloadAllDocuments()
 {
@@ -355,8 +454,8 @@ void Context::UnloadAllDocuments()
 
 	// The element lists may point to elements that are getting removed.
 	active_chain.clear();
-	hover_chain.clear();
-	drag_hover_chain.clear();
+	ClearChain(hover_chain, hover_chain_generation);
+	ClearChain(drag_hover_chain, drag_hover_chain_generation);
 }
 
 // Enables or disables the mouse cursor.
@@ -367,6 +466,28 @@ void Context::EnableMouseCursor(bool enable)
 	enable_cursor = enable;
 }
 
+void Context::EnableInputQueue(bool enable)
+{
+	input_queue_enabled = enable;
+	if (!enable)
+		ProcessInputQueue();
+}
+
+bool Context::IsInputQueueEnabled() const
+{
+	return input_queue_enabled;
+}
+
+const Context::InputQueueStatistics& Context::GetInputQueueStatistics() const
+{
+	return input_queue_statistics;
+}
+
+void Context::ResetInputQueueStatistics()
+{
+	input_queue_statistics = InputQueueStatistics();
+}
+
 // Returns the first document found in the root with the given id.
 ElementDocument* Context::GetDocument(const String& id)
 {
@@ -483,6 +604,9 @@ void Context::RemoveEventListener(const String& event, EventListener* listener,
 // Sends a key down event into RmlUi.
 bool Context::ProcessKeyDown(Input::KeyIdentifier key_identifier, int key_modifier_state)
 {
+	if (QueueInput(QueuedInput::Type::KeyDown, key_modifier_state, (int)key_identifier))
+		return true;
+
 	// Generate the parameters for the key event.
 	Dictionary parameters;
 	GenerateKeyEventParameters(parameters, key_identifier);
@@ -497,6 +621,9 @@ bool Context::ProcessKeyDown(Input::KeyIdentifier key_identifier, int key_modifi
 // Sends a key up event into RmlUi.
 bool Context::ProcessKeyUp(Input::KeyIdentifier key_identifier, int key_modifier_state)
 {
+	if (QueueInput(QueuedInput::Type::KeyUp, key_modifier_state, (int)key_identifier))
+		return true;
+
 	// Generate the parameters for the key event.
 	Dictionary parameters;
 	GenerateKeyEventParameters(parameters, key_identifier);
@@ -527,6 +654,9 @@ bool Context::ProcessTextInput(Character character)
 // Sends a string of text as text input into RmlUi.
 bool Context::ProcessTextInput(const String& string)
 {
+	if (QueueInput(QueuedInput::Type::TextInput, 0, 0, Vector2i(0, 0), 0.f, string))
+		return true;
+
 	Element* target = (focus ? focus : root.get());
 
 	Dictionary parameters;
@@ -540,6 +670,9 @@ bool Context::ProcessTextInput(const String& string)
 // Sends a mouse movement event into RmlUi.
 void Context::ProcessMouseMove(int x, int y, int key_modifier_state)
 {
+	if (QueueInput(QueuedInput::Type::MouseMove, key_modifier_state, 0, Vector2i(x, y)))
+		return;
+
 	// Check whether the mouse moved since the last event came through.
 	Vector2i old_mouse_position = mouse_position;
 	bool mouse_moved = (x != mouse_position.x) || (y != mouse_position.y);
@@ -549,15 +682,22 @@ void Context::ProcessMouseMove(int x, int y, int key_modifier_state)
 		mouse_position.y = y;
 	}
 
-	// Generate the parameters for the mouse events (there could be a few!).
-	Dictionary parameters;
+	// Generate the parameters for the mouse events (there could be a few!). The storage of the parameters is taken from
+	// the previous mouse move and handed back at the end, a nested call from a listener will simply allocate its own.
+	Dictionary parameters = std::move(mouse_move_parameters_scratch);
+	parameters.clear();
 	GenerateMouseEventParameters(parameters, -1);
 	GenerateKeyModifierEventParameters(parameters, key_modifier_state);
 
-	Dictionary drag_parameters;
-	GenerateMouseEventParameters(drag_parameters);
-	GenerateDragEventParameters(drag_parameters);
-	GenerateKeyModifierEventParameters(drag_parameters, key_modifier_state);
+	// The drag parameters are only used while dragging.
+	Dictionary drag_parameters = std::move(drag_move_parameters_scratch);
+	drag_parameters.clear();
+	if (drag)
+	{
+		GenerateMouseEventParameters(drag_parameters);
+		GenerateDragEventParameters(drag_parameters);
+		GenerateKeyModifierEventParameters(drag_parameters, key_modifier_state);
+	}
 
 	// Update the current hover chain. This will send all necessary 'onmouseout', 'onmouseover', 'ondragout' and
 	// 'ondragover' messages.
@@ -575,6 +715,9 @@ void Context::ProcessMouseMove(int x, int y, int key_modifier_state)
 				drag_hover->DispatchEvent(EventId::Dragmove, drag_parameters);
 		}
 	}
+
+	mouse_move_parameters_scratch = std::move(parameters);
+	drag_move_parameters_scratch = std::move(drag_parameters);
 }
 	
 static Element* FindFocusElement(Element* element)
@@ -594,6 +737,9 @@ static Element* FindFocusElement(Element* element)
 // Sends a mouse-button down event into RmlUi.
 void Context::ProcessMouseButtonDown(int button_index, int key_modifier_state)
 {
+	if (QueueInput(QueuedInput::Type::MouseButtonDown, key_modifier_state, button_index))
+		return;
+
 	Dictionary parameters;
 	GenerateMouseEventParameters(parameters, button_index);
 	GenerateKeyModifierEventParameters(parameters, key_modifier_state);
@@ -650,8 +796,7 @@ void Context::ProcessMouseButtonDown(int button_index, int key_modifier_state)
 
 		last_click_mouse_position = mouse_position;
 
-		for (ElementSet::iterator itr = hover_chain.begin(); itr != hover_chain.end(); ++itr)
-			active_chain.push_back((*itr));
+		active_chain.insert(active_chain.end(), hover_chain.begin(), hover_chain.end());
 
 		if (propagate)
 		{
@@ -683,6 +828,9 @@ void Context::ProcessMouseButtonDown(int button_index, int key_modifier_state)
 // Sends a mouse-button up event into RmlUi.
 void Context::ProcessMouseButtonUp(int button_index, int key_modifier_state)
 {
+	if (QueueInput(QueuedInput::Type::MouseButtonUp, key_modifier_state, button_index))
+		return;
+
 	Dictionary parameters;
 	GenerateMouseEventParameters(parameters, button_index);
 	GenerateKeyModifierEventParameters(parameters, key_modifier_state);
@@ -735,7 +883,7 @@ void Context::ProcessMouseButtonUp(int button_index, int key_modifier_state)
 
 			drag = nullptr;
 			drag_hover = nullptr;
-			drag_hover_chain.clear();
+			ClearChain(drag_hover_chain, drag_hover_chain_generation);
 
 			// We may have changes under our mouse, this ensures that the hover chain is properly updated
 			ProcessMouseMove(mouse_position.x, mouse_position.y, key_modifier_state);
@@ -752,6 +900,9 @@ void Context::ProcessMouseButtonUp(int button_index, int key_modifier_state)
 // Sends a mouse-wheel movement event into RmlUi.
 bool Context::ProcessMouseWheel(float wheel_delta, int key_modifier_state)
 {
+	if (QueueInput(QueuedInput::Type::MouseWheel, key_modifier_state, 0, Vector2i(0, 0), wheel_delta))
+		return true;
+
 	if (hover)
 	{
 		Dictionary scroll_parameters;
@@ -796,17 +947,59 @@ void Context::SetInstancer(ContextInstancer* _instancer)
 	instancer = _instancer;
 }
 
+// Internal callback for when an element is attached to the hierarchy.
+void Context::OnElementAttach(Element* element)
+{
+	if (element->descendant_update_deferred)
+		num_deferred_updates += 1;
+
+	if (!element->animations.empty())
+		ScheduleAnimations(element);
+
+	if (data_models.empty() || !DataModel::HasBindings(element))
+		return;
+
+	// Bind the element to the model named by its closest ancestor with the 'data-model' attribute.
+	for (Element* ancestor = element; ancestor; ancestor = ancestor->GetParentNode())
+	{
+		if (const Variant* model_name = ancestor->GetAttribute("data-model"))
+		{
+			auto it = data_models.find(model_name->Get<String>());
+			if (it != data_models.end())
+				it->second->BindElement(element);
+			return;
+		}
+	}
+}
+
 // Internal callback for when an element is removed from the hierarchy.
 void Context::OnElementDetach(Element* element)
 {
-	auto it_hover = hover_chain.find(element);
+	if (element->descendant_update_deferred)
+		num_deferred_updates -= 1;
+
+	if (element->animated_element_index >= 0)
+	{
+		// Clear the entry rather than erasing it, as we may be in the middle of advancing animations.
+		RMLUI_ASSERT(animated_elements[element->animated_element_index].get() == element);
+		animated_elements[element->animated_element_index].reset();
+		element->animated_element_index = -1;
+	}
+
+	DataModel::UnbindElement(element);
+
+	auto it_hover = std::find(hover_chain.begin(), hover_chain.end(), element);
 	if (it_hover != hover_chain.end())
 	{
 		Dictionary parameters;
 		GenerateMouseEventParameters(parameters, -1);
 		element->DispatchEvent(EventId::Mouseout, parameters);
 
-		hover_chain.erase(it_hover);
+		// Find the element again, as the chain may have changed during the event.
+		it_hover = std::find(hover_chain.begin(), hover_chain.end(), element);
+		if (it_hover != hover_chain.end())
+			hover_chain.erase(it_hover);
+		element->hover_chain_generation = 0;
 
 		if (hover == element)
 			hover = nullptr;
@@ -823,10 +1016,11 @@ void Context::OnElementDetach(Element* element)
 
 	if (drag)
 	{
-		auto it = drag_hover_chain.find(element);
+		auto it = std::find(drag_hover_chain.begin(), drag_hover_chain.end(), element);
 		if (it != drag_hover_chain.end())
 		{
 			drag_hover_chain.erase(it);
+			element->drag_hover_chain_generation = 0;
 
 			if (drag_hover == element)
 				drag_hover = nullptr;
@@ -840,7 +1034,7 @@ void Context::OnElementDetach(Element* element)
 
 			drag = nullptr;
 			drag_hover = nullptr;
-			drag_hover_chain.clear();
+			ClearChain(drag_hover_chain, drag_hover_chain_generation);
 		}
 	}
 
@@ -859,6 +1053,68 @@ void Context::OnElementDetach(Element* element)
 	}
 }
 
+void Context::ReleaseDeferredUpdates(Element* element)
+{
+	// The flag is cleared as well, as the elements may still be detached from the context while they are released.
+	if (element->descendant_update_deferred)
+	{
+		element->descendant_update_deferred = false;
+		num_deferred_updates -= 1;
+	}
+
+	for (int i = 0; i < element->GetNumChildren(true); i++)
+		ReleaseDeferredUpdates(element->GetChild(i));
+}
+
+void Context::ScheduleAnimations(Element* element)
+{
+	if (element->animated_element_index < 0)
+	{
+		element->animated_element_index = (int)animated_elements.size();
+		animated_elements.push_back(element->GetObserverPtr());
+	}
+}
+
+void Context::AdvanceAnimations()
+{
+	if (animated_elements.empty())
+		return;
+
+	RMLUI_ZoneScoped;
+
+	const double time = Clock::GetElapsedTime();
+
+	// Completed animations may dispatch events, and listeners may start animations on new elements. Those are added to
+	// the end of the list, and advanced during the next pass.
+	const size_t num_elements = animated_elements.size();
+	for (size_t i = 0; i < num_elements; i++)
+	{
+		if (Element* element = animated_elements[i].get())
+			element->AdvanceAnimations(time);
+	}
+
+	// Remove the elements which are destroyed, detached, or no longer animating, and update the indices of the rest.
+	size_t num_remaining = 0;
+	for (size_t i = 0; i < animated_elements.size(); i++)
+	{
+		Element* element = animated_elements[i].get();
+		if (!element)
+			continue;
+
+		if (element->animations.empty())
+		{
+			element->animated_element_index = -1;
+			continue;
+		}
+
+		element->animated_element_index = (int)num_remaining;
+		if (i != num_remaining)
+			animated_elements[num_remaining] = std::move(animated_elements[i]);
+		num_remaining++;
+	}
+	animated_elements.resize(num_remaining);
+}
+
 // Internal callback for when a new element gains focus
 bool Context::OnFocusChange(Element* new_focus)
 {
@@ -923,6 +1179,74 @@ bool Context::OnFocusChange(Element* new_focus)
 	return true;
 }
 
+bool Context::QueueInput(QueuedInput::Type type, int key_modifier_state, int index, Vector2i position, float wheel_delta, const String& text)
+{
+	if (!input_queue_enabled || processing_input_queue)
+		return false;
+
+	input_queue_statistics.queued_events += 1;
+
+	// Consecutive mouse moves and wheel movements are merged with the previous event, as long as the key modifiers are unchanged.
+	if (!input_queue.empty())
+	{
+		QueuedInput& previous = input_queue.back();
+		if (previous.type == type && previous.key_modifier_state == key_modifier_state)
+		{
+			if (type == QueuedInput::Type::MouseMove)
+			{
+				previous.mouse_position = position;
+				input_queue_statistics.coalesced_events += 1;
+				return true;
+			}
+			else if (type == QueuedInput::Type::MouseWheel)
+			{
+				previous.wheel_delta += wheel_delta;
+				input_queue_statistics.coalesced_events += 1;
+				return true;
+			}
+		}
+	}
+
+	input_queue.push_back(QueuedInput{ type, key_modifier_state, index, position, wheel_delta, text });
+
+	return true;
+}
+
+void Context::ProcessInputQueue()
+{
+	if (input_queue.empty() || processing_input_queue)
+		return;
+
+	RMLUI_ZoneScoped;
+
+	std::vector< QueuedInput > queue;
+	queue.swap(input_queue);
+
+	processing_input_queue = true;
+
+	for (const QueuedInput& input : queue)
+	{
+		switch (input.type)
+		{
+		case QueuedInput::Type::KeyDown:         ProcessKeyDown((Input::KeyIdentifier)input.index, input.key_modifier_state); break;
+		case QueuedInput::Type::KeyUp:           ProcessKeyUp((Input::KeyIdentifier)input.index, input.key_modifier_state); break;
+		case QueuedInput::Type::TextInput:       ProcessTextInput(input.text); break;
+		case QueuedInput::Type::MouseMove:       ProcessMouseMove(input.mouse_position.x, input.mouse_position.y, input.key_modifier_state); break;
+		case QueuedInput::Type::MouseButtonDown: ProcessMouseButtonDown(input.index, input.key_modifier_state); break;
+		case QueuedInput::Type::MouseButtonUp:   ProcessMouseButtonUp(input.index, input.key_modifier_state); break;
+		case QueuedInput::Type::MouseWheel:      ProcessMouseWheel(input.wheel_delta, input.key_modifier_state); break;
+		}
+	}
+
+	processing_input_queue = false;
+	input_queue_statistics.processed_events += (int)queue.size();
+
+	// Keep the storage of the queue for the following frames.
+	queue.clear();
+	if (input_queue.empty())
+		input_queue.swap(queue);
+}
+
 // Generates an event for faking clicks on an element.
 void Context::GenerateClickEvent(Element* element)
 {
@@ -979,45 +1303,90 @@ void Context::UpdateHoverChain(const Dictionary& parameters, const Dictionary& d
 		}
 	}
 
-	// Build the new hover chain.
-	ElementSet new_hover_chain;
-	Element* element = hover;
-	while (element != nullptr)
-	{
-		new_hover_chain.insert(element);
-		element = element->GetParentNode();
-	}
-
-	// Send mouseout / mouseover events.
-	SendEvents(hover_chain, new_hover_chain, EventId::Mouseout, parameters);
-	SendEvents(new_hover_chain, hover_chain, EventId::Mouseover, parameters);
+	// Rebuild the hover chain, sending mouseout / mouseover events.
+	UpdateChain(hover_chain, hover_chain_generation, &Element::hover_chain_generation, hover, EventId::Mouseout, EventId::Mouseover, &parameters);
 
 	// Send out drag events.
 	if (drag)
 	{
-		drag_hover = GetElementAtPoint(position, drag);
+		// The drag hover element only differs from the hover element when hovering the dragged element or its descendants,
+		// which is the case if the dragged element is part of the current hover chain.
+		if (drag->hover_chain_generation == hover_chain_generation)
+			drag_hover = GetElementAtPoint(position, drag);
+		else
+			drag_hover = hover;
+
+		// Send out ondragover and ondragout events as appropriate.
+		const bool send_drag_events = (drag_started && drag_verbose);
+		UpdateChain(drag_hover_chain, drag_hover_chain_generation, &Element::drag_hover_chain_generation, drag_hover, EventId::Dragout, EventId::Dragover, send_drag_events ? &drag_parameters : nullptr);
+	}
+}
 
-		ElementSet new_drag_hover_chain;
-		element = drag_hover;
-		while (element != nullptr)
-		{
-			new_drag_hover_chain.insert(element);
-			element = element->GetParentNode();
-		}
+void Context::UpdateChain(ElementList& chain, unsigned int& generation, unsigned int Element::* element_generation, Element* element, EventId leave_id, EventId enter_id, const Dictionary* parameters)
+{
+	// The elements of the current chain are stamped with the current generation. While building the new chain, its elements
+	// are stamped with the next generation. Thus, elements with the previous stamp were already part of the chain, and
+	// elements of the old chain which were not restamped have left the chain. No sorting or lookups are needed.
+	const unsigned int previous_generation = generation;
+	generation = NextChainGeneration(generation);
+
+	// The storage is taken from the scratch containers and handed back at the end. Listeners may update the chains
+	// recursively, in which case the scratch containers are empty and the nested call simply allocates its own.
+	ElementList new_chain = std::move(chain_scratch);
+	std::vector< ObserverPtr<Element> > enter_elements = std::move(chain_enter_scratch);
+	std::vector< ObserverPtr<Element> > leave_elements = std::move(chain_leave_scratch);
+	new_chain.clear();
+	enter_elements.clear();
+	leave_elements.clear();
+
+	for (Element* new_element = element; new_element; new_element = new_element->GetParentNode())
+	{
+		if (parameters && new_element->*element_generation != previous_generation)
+			enter_elements.push_back(new_element->GetObserverPtr());
 
-		if (drag_started &&
-			drag_verbose)
+		new_element->*element_generation = generation;
+		new_chain.push_back(new_element);
+	}
+
+	if (parameters)
+	{
+		for (Element* old_element : chain)
 		{
-			// Send out ondragover and ondragout events as appropriate.
-			SendEvents(drag_hover_chain, new_drag_hover_chain, EventId::Dragout, drag_parameters);
-			SendEvents(new_drag_hover_chain, drag_hover_chain, EventId::Dragover, drag_parameters);
+			if (old_element->*element_generation != generation)
+				leave_elements.push_back(old_element->GetObserverPtr());
 		}
+	}
+
+	// Swap the new chain in before sending events, so that any listeners see the current state.
+	chain.swap(new_chain);
 
-		drag_hover_chain.swap(new_drag_hover_chain);
+	// Elements leave the chain from the innermost element outwards, and enter it from the outermost element inwards.
+	// We hold them in observer pointers in case some of them are deleted during dispatch.
+	for (auto& leave_element : leave_elements)
+	{
+		if (leave_element)
+			leave_element->DispatchEvent(leave_id, *parameters);
 	}
+	for (auto it = enter_elements.rbegin(); it != enter_elements.rend(); ++it)
+	{
+		if (*it)
+			(*it)->DispatchEvent(enter_id, *parameters);
+	}
+
+	new_chain.clear();
+	enter_elements.clear();
+	leave_elements.clear();
+	chain_scratch = std::move(new_chain);
+	chain_enter_scratch = std::move(enter_elements);
+	chain_leave_scratch = std::move(leave_elements);
+}
 
-	// Swap the new chain in.
-	hover_chain.swap(new_hover_chain);
+void Context::ClearChain(ElementList& chain, unsigned int& generation)
+{
+	// The elements may already be destroyed. Instead of resetting their stamps, skip a generation so that none of the
+	// stamps match the previous generation of the next update.
+	chain.clear();
+	generation = NextChainGeneration(generation);
 }
 
 // Returns the youngest descendent of the given element which is under the given point in screen coodinates.
@@ -1196,11 +1565,46 @@ void Context::ReleaseUnloadedDocuments()
 
 		// Clear the deleted list.
 		for (size_t i = 0; i < documents.size(); ++i)
+		{
 			documents[i]->GetEventDispatcher()->DetachAllEvents();
+
+			DataModel::UnbindElement(documents[i].get());
+		}
 		documents.clear();
 	}
 }
 
+void Context::FlushMutationBatch()
+{
+	RMLUI_ZoneScoped;
+
+	// Notifications may mutate the tree again, which is then performed immediately as the batch is no longer active.
+	std::vector< ObserverPtr<Element> > added_elements = std::move(batch_added_elements);
+	batch_added_elements.clear();
+
+	for (auto& element : added_elements)
+	{
+		// The flag is cleared if the element was removed again during the batch, or already notified.
+		if (element && element->batch_child_add_pending)
+		{
+			element->batch_child_add_pending = false;
+			element->NotifyChildAdd();
+		}
+	}
+
+	std::vector< ObserverPtr<Element> > stacking_context_elements = std::move(batch_stacking_context_elements);
+	batch_stacking_context_elements.clear();
+
+	for (auto& element : stacking_context_elements)
+	{
+		if (element && element->batch_stacking_context_pending)
+		{
+			element->batch_stacking_context_pending = false;
+			element->DirtyStackingContext();
+		}
+	}
+}
+
 using ElementObserverList = std::vector< ObserverPtr<Element> >;
 
 class ElementObserverListBackInserter {
@@ -1246,5 +1650,17 @@ void Context::Release()
 	}
 }
 
+ScopedMutationBatch::ScopedMutationBatch(Context* context) : context(context)
+{
+	if (context)
+		context->BeginMutationBatch();
+}
+
+ScopedMutationBatch::~ScopedMutationBatch()
+{
+	if (context)
+		context->EndMutationBatch();
+}
+
 }
 }
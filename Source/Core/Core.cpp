@@ -43,11 +43,15 @@
 #include "PluginRegistry.h"
 #include "StyleSheetFactory.h"
 #include "TemplateCache.h"
+#include "TextureAtlas.h"
 #include "TextureDatabase.h"
+#include "TextureLoader.h"
 #include "EventSpecification.h"
 
 #ifndef RMLUI_NO_FONT_INTERFACE_DEFAULT
 #include "FontEngineDefault/FontEngineInterfaceDefault.h"
+#include "FontEngineDefault/FontGlyphCache.h"
+#include "FontEngineDefault/FontProvider.h"
 #endif
 
 
@@ -309,6 +313,50 @@ bool LoadFontFace(const byte* data, int data_size, const String& font_family, St
 	return font_interface->LoadFontFace(data, data_size, font_family, style, weight, fallback_face);
 }
 
+void SetFontCacheDirectory(const String& directory)
+{
+#ifndef RMLUI_NO_FONT_INTERFACE_DEFAULT
+	FontGlyphCache::SetDirectory(directory);
+#else
+	(void)directory;
+#endif
+}
+
+void SetFontMemoryBudget(size_t budget, double idle_time)
+{
+#ifndef RMLUI_NO_FONT_INTERFACE_DEFAULT
+	FontProvider::SetMemoryBudget(budget, idle_time);
+#else
+	(void)budget;
+	(void)idle_time;
+#endif
+}
+
+void EnableTextureAtlas(const TextureCallback& decode_callback, int max_texture_size, int max_page_size)
+{
+	TextureAtlas::Enable(decode_callback, max_texture_size, max_page_size);
+}
+
+TextureAtlasStatistics GetTextureAtlasStatistics()
+{
+	return TextureAtlas::GetStatistics();
+}
+
+void SetTextureMemoryBudget(size_t budget, int idle_frames)
+{
+	TextureDatabase::SetMemoryBudget(budget, idle_frames);
+}
+
+std::vector<ResidentTexture> GetResidentTextures()
+{
+	return TextureDatabase::GetResidentTextures();
+}
+
+void EnableAsyncTextureLoading(const TextureCallback& decode_callback, int num_threads, const TextureDimensionsCallback& dimensions_callback)
+{
+	TextureLoader::Enable(decode_callback, dimensions_callback, num_threads);
+}
+
 // Registers a generic rmlui plugin
 void RegisterPlugin(Plugin* plugin)
 {
@@ -0,0 +1,352 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../../Include/RmlUi/Core/DataModel.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/ElementText.h"
+#include "../../Include/RmlUi/Core/Log.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
+#include "DataView.h"
+#include <algorithm>
+#include <stdlib.h>
+
+namespace Rml {
+namespace Core {
+
+DataModel::DataModel(const String& name) : name(name)
+{}
+
+DataModel::~DataModel()
+{
+	// The views outlive the model, as they are owned by their elements.
+	for (Slot& slot : slots)
+	{
+		for (DataView* view : slot.views)
+			view->model = nullptr;
+	}
+}
+
+const String& DataModel::GetName() const
+{
+	return name;
+}
+
+void DataModel::SetValue(const String& name, const Variant& value)
+{
+	SetSlotValue(GetSlot(name), value);
+}
+
+const Variant* DataModel::GetValue(const String& name) const
+{
+	return GetSlotValue(FindSlot(name));
+}
+
+void DataModel::SetArraySize(const String& name, int size)
+{
+	size = Math::Max(size, 0);
+
+	const int slot = GetSlot(name);
+	const int old_size = slots[slot].array_size;
+	if (old_size == size)
+		return;
+
+	slots[slot].array_size = size;
+
+	if (size < old_size)
+	{
+		// Forget the values of the removed entries, so that they don't reappear if the array grows again.
+		const String prefix = name + '[';
+		for (Slot& entry : slots)
+		{
+			const String& address = entry.address;
+			if (address.compare(0, prefix.size(), prefix) == 0 && atoi(address.c_str() + prefix.size()) >= size)
+			{
+				entry.value.Clear();
+				entry.has_value = false;
+				entry.array_size = 0;
+			}
+		}
+	}
+
+	DirtySlot(slot);
+}
+
+int DataModel::GetArraySize(const String& name) const
+{
+	return GetSlotArraySize(FindSlot(name));
+}
+
+void DataModel::SetArrayValue(const String& name, int index, const Variant& value)
+{
+	SetValue(GetArrayHandle(name, index), value);
+}
+
+void DataModel::SetArrayValue(const String& name, int index, const String& member, const Variant& value)
+{
+	SetValue(GetArrayHandle(name, index, member), value);
+}
+
+DataModel::ValueHandle DataModel::GetHandle(const String& name)
+{
+	ValueHandle handle;
+	handle.slot = GetSlot(name);
+	return handle;
+}
+
+DataModel::ValueHandle DataModel::GetArrayHandle(const String& name, int index)
+{
+	RMLUI_ASSERT(index >= 0);
+	return GetHandle(DataView::CreateEntryAddress(name, index));
+}
+
+DataModel::ValueHandle DataModel::GetArrayHandle(const String& name, int index, const String& member)
+{
+	RMLUI_ASSERT(index >= 0);
+	return GetHandle(DataView::CreateEntryAddress(name, index) + '.' + member);
+}
+
+void DataModel::SetValue(ValueHandle handle, const Variant& value)
+{
+	RMLUI_ASSERTMSG(handle.slot >= 0 && handle.slot < (int)slots.size(), "Invalid data model value handle.");
+	SetSlotValue(handle.slot, value);
+}
+
+bool DataModel::HasBindings(Element* element)
+{
+	const ElementDataViews& data_views = element->GetDataViews();
+	if (data_views.created)
+		return !data_views.views.empty();
+
+	if (ElementText* text_element = rmlui_dynamic_cast<ElementText*>(element))
+		return text_element->GetText().find("{{") != String::npos;
+
+	for (const auto& pair : element->GetAttributes())
+	{
+		if (pair.first.compare(0, 5, "data-") == 0 && pair.first != "data-model")
+			return true;
+	}
+
+	return false;
+}
+
+void DataModel::BindElement(Element* element)
+{
+	ElementDataViews& data_views = element->GetDataViews();
+
+	if (!data_views.created)
+	{
+		// Elements inside a repeated element are only bound once repeated, the original merely acts as a template.
+		for (Element* ancestor = element->GetParentNode(); ancestor; ancestor = ancestor->GetParentNode())
+		{
+			if (ancestor->HasAttribute("data-for"))
+				return;
+			if (ancestor->HasAttribute("data-model"))
+				break;
+		}
+
+		data_views.created = true;
+		CreateViews(element, data_views.views);
+	}
+
+	for (const UniquePtr<DataView>& view : data_views.views)
+		AddView(view.get());
+}
+
+void DataModel::UnbindElement(Element* element)
+{
+	for (const UniquePtr<DataView>& view : element->GetDataViews().views)
+	{
+		if (view->model)
+			view->model->RemoveView(view.get());
+	}
+}
+
+void DataModel::CreateViews(Element* element, std::vector< UniquePtr<DataView> >& views)
+{
+	if (ElementText* text_element = rmlui_dynamic_cast<ElementText*>(element))
+	{
+		const String& text = text_element->GetText();
+		if (text.find("{{") != String::npos)
+			views.push_back(std::make_unique<DataViewText>(element, text));
+		return;
+	}
+
+	if (const Variant* repeat = element->GetAttribute("data-for"))
+	{
+		const String value = repeat->Get<String>();
+		const size_t separator = value.find(':');
+		if (separator == String::npos)
+		{
+			Log::Message(Log::LT_WARNING, "Invalid data-for attribute '%s' on element %s, expected 'item : array'.", value.c_str(), element->GetAddress().c_str());
+			return;
+		}
+
+		const String alias = StringUtilities::StripWhitespace(value.substr(0, separator));
+		const String address = DataView::ResolveAddress(element, value.substr(separator + 1));
+		views.push_back(std::make_unique<DataViewRepeat>(element, alias, address));
+		return;
+	}
+
+	for (const auto& pair : element->GetAttributes())
+	{
+		const String& attribute_name = pair.first;
+		if (attribute_name.compare(0, 5, "data-") != 0)
+			continue;
+
+		if (attribute_name.compare(5, 5, "attr-") == 0)
+			views.push_back(std::make_unique<DataViewAttribute>(element, attribute_name.substr(10), DataView::ResolveAddress(element, pair.second.Get<String>())));
+		else if (attribute_name.compare(5, 6, "class-") == 0)
+			views.push_back(std::make_unique<DataViewClass>(element, attribute_name.substr(11), DataView::ResolveAddress(element, pair.second.Get<String>())));
+		else if (attribute_name.compare(5, 6, "style-") == 0)
+			views.push_back(std::make_unique<DataViewStyle>(element, attribute_name.substr(11), DataView::ResolveAddress(element, pair.second.Get<String>())));
+	}
+}
+
+void DataModel::Update()
+{
+	RMLUI_ZoneScoped;
+
+	// Views may add and remove other views while updating, thus we always pick the next view from the dirty sets.
+	while (!dirty_repeat_views.empty() || !dirty_views.empty())
+	{
+		UnorderedSet< DataView* >& views = (dirty_repeat_views.empty() ? dirty_views : dirty_repeat_views);
+
+		auto it = views.begin();
+		DataView* view = *it;
+		views.erase(it);
+
+		view->Update(*this);
+	}
+}
+
+int DataModel::GetSlot(const String& address)
+{
+	auto it = slot_indices.find(address);
+	if (it != slot_indices.end())
+		return it->second;
+
+	const int slot = (int)slots.size();
+	slots.emplace_back();
+	slots.back().address = address;
+	slot_indices.emplace(address, slot);
+
+	return slot;
+}
+
+int DataModel::FindSlot(const String& address) const
+{
+	auto it = slot_indices.find(address);
+	if (it == slot_indices.end())
+		return -1;
+
+	return it->second;
+}
+
+const Variant* DataModel::GetSlotValue(int slot) const
+{
+	if (slot < 0 || !slots[slot].has_value)
+		return nullptr;
+
+	return &slots[slot].value;
+}
+
+int DataModel::GetSlotArraySize(int slot) const
+{
+	if (slot < 0)
+		return 0;
+
+	return slots[slot].array_size;
+}
+
+void DataModel::SetSlotValue(int slot, const Variant& value)
+{
+	Slot& entry = slots[slot];
+	if (entry.has_value && entry.value == value)
+		return;
+
+	entry.value = value;
+	entry.has_value = true;
+
+	DirtySlot(slot);
+}
+
+void DataModel::DirtySlot(int slot)
+{
+	for (DataView* view : slots[slot].views)
+	{
+		if (view->IsRepeat())
+			dirty_repeat_views.insert(view);
+		else
+			dirty_views.insert(view);
+	}
+}
+
+void DataModel::AddView(DataView* view)
+{
+	if (view->model == this)
+		return;
+	if (view->model)
+		view->model->RemoveView(view);
+
+	view->model = this;
+	view->slots.resize(view->addresses.size());
+
+	for (size_t i = 0; i < view->addresses.size(); i++)
+	{
+		const int slot = GetSlot(view->addresses[i]);
+		view->slots[i] = slot;
+		slots[slot].views.push_back(view);
+	}
+
+	// The view may have missed changes while unregistered, or is new.
+	if (view->IsRepeat())
+		dirty_repeat_views.insert(view);
+	else
+		dirty_views.insert(view);
+}
+
+void DataModel::RemoveView(DataView* view)
+{
+	RMLUI_ASSERT(view->model == this);
+
+	for (int slot : view->slots)
+	{
+		DataViewList& views = slots[slot].views;
+		views.erase(std::remove(views.begin(), views.end(), view), views.end());
+	}
+
+	dirty_views.erase(view);
+	dirty_repeat_views.erase(view);
+
+	view->model = nullptr;
+}
+
+}
+}
@@ -0,0 +1,311 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "DataView.h"
+#include "../../Include/RmlUi/Core/Context.h"
+#include "../../Include/RmlUi/Core/DataModel.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/ElementText.h"
+#include "../../Include/RmlUi/Core/Factory.h"
+#include "../../Include/RmlUi/Core/Property.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
+#include "../../Include/RmlUi/Core/PropertyDefinition.h"
+#include "../../Include/RmlUi/Core/StyleSheetSpecification.h"
+#include <algorithm>
+
+namespace Rml {
+namespace Core {
+
+DataView::DataView(Element* element) : element(element), model(nullptr)
+{}
+
+DataView::~DataView()
+{
+	if (model)
+		model->RemoveView(this);
+}
+
+bool DataView::IsRepeat() const
+{
+	return false;
+}
+
+const StringList& DataView::GetAddresses() const
+{
+	return addresses;
+}
+
+const Variant* DataView::GetValue(const DataModel& model, size_t i) const
+{
+	return model.GetSlotValue(slots[i]);
+}
+
+int DataView::GetArraySize(const DataModel& model, size_t i) const
+{
+	return model.GetSlotArraySize(slots[i]);
+}
+
+String DataView::ResolveAddress(Element* element, const String& name)
+{
+	const String stripped_name = StringUtilities::StripWhitespace(name);
+	const size_t head_end = stripped_name.find_first_of(".[");
+	const String alias_attribute = "data-alias-" + stripped_name.substr(0, head_end);
+
+	// Search for the closest repeated ancestor declaring the alias, but don't look outside the data model.
+	for (Element* ancestor = element; ancestor; ancestor = ancestor->GetParentNode())
+	{
+		if (const Variant* alias_address = ancestor->GetAttribute(alias_attribute))
+		{
+			if (head_end == String::npos)
+				return alias_address->Get<String>();
+			return alias_address->Get<String>() + stripped_name.substr(head_end);
+		}
+
+		if (ancestor->HasAttribute("data-model"))
+			break;
+	}
+
+	return stripped_name;
+}
+
+String DataView::CreateEntryAddress(const String& array_address, int index)
+{
+	return CreateString(array_address.size() + 32, "%s[%d]", array_address.c_str(), index);
+}
+
+
+
+DataViewText::DataViewText(Element* element, const String& text) : DataView(element)
+{
+	size_t begin = 0;
+	while (true)
+	{
+		const size_t open = text.find("{{", begin);
+		if (open == String::npos)
+			break;
+
+		const size_t close = text.find("}}", open + 2);
+		if (close == String::npos)
+			break;
+
+		literals.push_back(text.substr(begin, open - begin));
+		addresses.push_back(ResolveAddress(element, text.substr(open + 2, close - open - 2)));
+
+		begin = close + 2;
+	}
+
+	literals.push_back(text.substr(begin));
+}
+
+void DataViewText::Update(DataModel& model)
+{
+	String text = literals[0];
+	for (size_t i = 0; i < addresses.size(); i++)
+	{
+		if (const Variant* value = GetValue(model, i))
+			text += value->Get<String>();
+		text += literals[i + 1];
+	}
+
+	ElementText* text_element = static_cast<ElementText*>(element);
+	if (text != text_element->GetText())
+		text_element->SetText(text);
+}
+
+
+
+DataViewAttribute::DataViewAttribute(Element* element, const String& attribute_name, const String& address) : DataView(element), attribute_name(attribute_name)
+{
+	addresses.push_back(address);
+}
+
+void DataViewAttribute::Update(DataModel& model)
+{
+	if (const Variant* value = GetValue(model, 0))
+	{
+		const Variant* current_value = element->GetAttribute(attribute_name);
+		if (!current_value || *current_value != *value)
+			element->SetAttribute(attribute_name, *value);
+	}
+	else if (element->HasAttribute(attribute_name))
+	{
+		element->RemoveAttribute(attribute_name);
+	}
+}
+
+
+
+DataViewClass::DataViewClass(Element* element, const String& class_name, const String& address) : DataView(element), class_name(class_name)
+{
+	addresses.push_back(address);
+}
+
+void DataViewClass::Update(DataModel& model)
+{
+	const Variant* value = GetValue(model, 0);
+	const bool activate = (value && value->Get<bool>());
+
+	if (element->IsClassSet(class_name) != activate)
+		element->SetClass(class_name, activate);
+}
+
+
+
+DataViewStyle::DataViewStyle(Element* element, const String& property_name, const String& address) : DataView(element), property_name(property_name), number_unit(Property::UNKNOWN)
+{
+	addresses.push_back(address);
+
+	// Shorthands have no id, they are always set through their parser.
+	id = StyleSheetSpecification::GetPropertyId(property_name);
+
+	// Find out once how the property interprets numbers without a unit, so that numeric values can be applied directly.
+	if (const PropertyDefinition* definition = StyleSheetSpecification::GetProperty(id))
+	{
+		Property number;
+		if (definition->ParseValue(number, "0") && (number.unit & Property::NUMBER_LENGTH_PERCENT))
+			number_unit = number.unit;
+	}
+}
+
+void DataViewStyle::Update(DataModel& model)
+{
+	const Variant* value = GetValue(model, 0);
+	if (!value)
+	{
+		element->RemoveProperty(property_name);
+		return;
+	}
+
+	if (id != PropertyId::Invalid)
+	{
+		switch (value->GetType())
+		{
+		case Variant::COLOURB:
+			element->SetProperty(id, Property(value->Get<Colourb>(), Property::COLOUR));
+			return;
+		case Variant::BYTE:
+		case Variant::CHAR:
+		case Variant::FLOAT:
+		case Variant::INT:
+		case Variant::WORD:
+			if (number_unit != Property::UNKNOWN)
+			{
+				element->SetProperty(id, Property(value->Get<float>(), number_unit));
+				return;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Strings and other values are parsed by the property's own parser.
+	element->SetProperty(property_name, value->Get<String>());
+}
+
+
+
+DataViewRepeat::DataViewRepeat(Element* element, const String& alias, const String& address) : DataView(element), alias(alias), initialized(false)
+{
+	addresses.push_back(address);
+
+	clone_attributes = element->GetAttributes();
+	clone_attributes.erase("data-for");
+
+	// The element itself only acts as a template for the repeated elements.
+	element->SetProperty(PropertyId::Display, Property(Style::Display::None));
+}
+
+void DataViewRepeat::Update(DataModel& model)
+{
+	Element* parent = element->GetParentNode();
+	if (!parent)
+		return;
+
+	// The contents of the template may not have been instanced yet when the view was created.
+	if (!initialized)
+	{
+		clone_rml = element->GetInnerRML();
+		initialized = true;
+	}
+
+	const int size = GetArraySize(model, 0);
+
+	ScopedMutationBatch mutation_batch(element->GetContext());
+
+	// The repeated elements are kept while the template is detached. If any of them were removed or left behind when
+	// the template was moved, they are all repeated again, as each is bound to the entry at its position.
+	const bool clones_misplaced = std::any_of(clones.begin(), clones.end(), [parent](const ObserverPtr<Element>& clone) {
+		return !clone || clone->GetParentNode() != parent;
+	});
+	if (clones_misplaced)
+	{
+		for (ObserverPtr<Element>& clone : clones)
+		{
+			if (clone && clone->GetParentNode())
+				clone->GetParentNode()->RemoveChild(clone.get());
+		}
+		clones.clear();
+	}
+
+	while ((int)clones.size() > size)
+	{
+		ObserverPtr<Element> clone = std::move(clones.back());
+		clones.pop_back();
+
+		if (clone && clone->GetParentNode() == parent)
+			parent->RemoveChild(clone.get());
+	}
+
+	const String alias_attribute = "data-alias-" + alias;
+	const String& tag = element->GetTagName();
+
+	// Repeated elements are placed in front of the template, they are bound to the model when attached.
+	for (int i = (int)clones.size(); i < size; i++)
+	{
+		ElementAttributes attributes = clone_attributes;
+		attributes[alias_attribute] = Variant(CreateEntryAddress(addresses[0], i));
+
+		ElementPtr clone = Factory::InstanceElement(parent, tag, tag, attributes);
+		if (!clone)
+			break;
+
+		Factory::InstanceElementText(clone.get(), clone_rml);
+
+		clones.push_back(clone->GetObserverPtr());
+		parent->InsertBefore(std::move(clone), element);
+	}
+}
+
+bool DataViewRepeat::IsRepeat() const
+{
+	return true;
+}
+
+}
+}
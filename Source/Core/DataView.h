@@ -0,0 +1,174 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUICOREDATAVIEW_H
+#define RMLUICOREDATAVIEW_H
+
+#include "../../Include/RmlUi/Core/Types.h"
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/ObserverPtr.h"
+#include "../../Include/RmlUi/Core/Property.h"
+
+namespace Rml {
+namespace Core {
+
+class DataModel;
+class Element;
+
+/**
+	A view applies one or more values of a data model to the element it is bound to.
+
+	Views are created by the data model from the binding attributes and text of the element when it is first bound, and
+	are owned by the element. They are registered with the model while the element is attached to its context.
+ */
+
+class DataView : public NonCopyMoveable
+{
+public:
+	DataView(Element* element);
+	virtual ~DataView();
+
+	/// Applies the current values of the model to the element.
+	virtual void Update(DataModel& model) = 0;
+
+	/// Returns true if this view repeats elements, and thereby creates and destroys other views when updated.
+	virtual bool IsRepeat() const;
+
+	/// Returns the addresses of the values this view depends on.
+	const StringList& GetAddresses() const;
+
+	/// Resolves a name as written in the RML of an element, such as 'item.member', into the address of a value in the
+	/// model, such as 'array[2].member'. Aliases declared by repeated ancestor elements are substituted.
+	static String ResolveAddress(Element* element, const String& name);
+	/// Returns the address of an entry in an array.
+	static String CreateEntryAddress(const String& array_address, int index);
+
+protected:
+	/// Returns the value of one of the addresses of this view, or nullptr if it has not been set.
+	const Variant* GetValue(const DataModel& model, size_t i) const;
+	/// Returns the array size at one of the addresses of this view.
+	int GetArraySize(const DataModel& model, size_t i) const;
+
+	Element* element;
+	StringList addresses;
+	// The slots of the addresses in the model this view is registered with.
+	std::vector< int > slots;
+
+private:
+	// The model this view is registered with, or nullptr if not registered.
+	DataModel* model;
+
+	friend class DataModel;
+};
+
+/**
+	The views created from the bindings of an element, kept with the element so that they survive it being detached.
+ */
+
+struct ElementDataViews
+{
+	std::vector< UniquePtr<DataView> > views;
+	// True once the bindings of the element have been read. They are never read again, as the views modify the element.
+	bool created = false;
+};
+
+
+class DataViewText final : public DataView
+{
+public:
+	DataViewText(Element* element, const String& text);
+
+	void Update(DataModel& model) override;
+
+private:
+	// The literal text surrounding each value, always one more entry than the number of addresses.
+	StringList literals;
+};
+
+
+class DataViewAttribute final : public DataView
+{
+public:
+	DataViewAttribute(Element* element, const String& attribute_name, const String& address);
+
+	void Update(DataModel& model) override;
+
+private:
+	String attribute_name;
+};
+
+
+class DataViewClass final : public DataView
+{
+public:
+	DataViewClass(Element* element, const String& class_name, const String& address);
+
+	void Update(DataModel& model) override;
+
+private:
+	String class_name;
+};
+
+
+class DataViewStyle final : public DataView
+{
+public:
+	DataViewStyle(Element* element, const String& property_name, const String& address);
+
+	void Update(DataModel& model) override;
+
+private:
+	String property_name;
+	PropertyId id;
+	// The unit of numbers written without a unit for this property, or UNKNOWN if numbers must be parsed.
+	Property::Unit number_unit;
+};
+
+
+class DataViewRepeat final : public DataView
+{
+public:
+	DataViewRepeat(Element* element, const String& alias, const String& address);
+
+	void Update(DataModel& model) override;
+
+	bool IsRepeat() const override;
+
+private:
+	String alias;
+	ElementAttributes clone_attributes;
+	String clone_rml;
+	bool initialized;
+
+	std::vector< ObserverPtr<Element> > clones;
+};
+
+}
+}
+
+#endif
@@ -33,6 +33,7 @@
 #include "../../Include/RmlUi/Core/ElementDocument.h"
 #include "../../Include/RmlUi/Core/ElementInstancer.h"
 #include "../../Include/RmlUi/Core/ElementScroll.h"
+#include "../../Include/RmlUi/Core/ElementText.h"
 #include "../../Include/RmlUi/Core/ElementUtilities.h"
 #include "../../Include/RmlUi/Core/Factory.h"
 #include "../../Include/RmlUi/Core/Dictionary.h"
@@ -45,6 +46,7 @@
 #include "../../Include/RmlUi/Core/TransformState.h"
 #include "Clock.h"
 #include "ComputeProperty.h"
+#include "DataView.h"
 #include "ElementAnimation.h"
 #include "ElementBackground.h"
 #include "ElementBorder.h"
@@ -62,6 +64,7 @@
 #include "XMLParseTools.h"
 #include <algorithm>
 #include <cmath>
+#include <iterator>
 
 namespace Rml {
 namespace Core {
@@ -107,6 +110,7 @@ struct ElementMeta
 	ElementDecoration decoration;
 	ElementScroll scroll;
 	Style::ComputedValues computed_values;
+	ElementDataViews data_views;
 };
 
 
@@ -141,6 +145,21 @@ transform_state(), dirty_transform(false), dirty_perspective(false), dirty_anima
 
 	structure_dirty = false;
 
+	update_dirty = true;
+	descendant_update_dirty = false;
+	continuous_update = false;
+	descendant_update_deferred = false;
+
+	batch_child_add_pending = false;
+	batch_stacking_context_pending = false;
+
+	// Zero is never used by the context as a chain generation, so new elements are not part of any chain.
+	hover_chain_generation = 0;
+	drag_hover_chain_generation = 0;
+
+	animated_element_index = -1;
+	animations_started = false;
+
 	computed_values_are_default_initialized = true;
 
 	clipping_ignore_depth = 0;
@@ -162,10 +181,7 @@ Element::~Element()
 	// A simplified version of RemoveChild() for destruction.
 	for (ElementPtr& child : children)
 	{
-		Element* child_ancestor = child.get();
-		for (int i = 0; i <= ChildNotifyLevels && child_ancestor; i++, child_ancestor = child_ancestor->GetParentNode())
-			child_ancestor->OnChildRemove(child.get());
-
+		child->NotifyChildRemove();
 		child->SetParent(nullptr);
 	}
 
@@ -175,38 +191,126 @@ Element::~Element()
 	element_meta_chunk_pool.DestroyAndDeallocate(meta);
 }
 
-void Element::Update(float dp_ratio)
+void Element::Update(float dp_ratio, bool update_hidden)
+{
+	UpdateElement(dp_ratio, update_hidden, true);
+}
+
+void Element::UpdateElement(float dp_ratio, bool update_hidden, bool start_transitions)
 {
 	RMLUI_ZoneScoped;
 
-	OnUpdate();
+	// The flags are cleared before the element is updated, so that any changes made during the update are picked up
+	// during the next update.
+	if (update_dirty)
+	{
+		update_dirty = false;
 
-	UpdateStructure();
+		OnUpdate();
 
-	HandleTransitionProperty();
-	HandleAnimationProperty();
-	AdvanceAnimations();
+		UpdateStructure();
 
-	meta->scroll.Update();
+		// Running animations are advanced by the context before the update traversal, here we start and stop them
+		// according to the 'transition' and 'animation' properties. Newly started animations are applied immediately,
+		// so that their initial values are rendered in this frame.
+		HandleTransitionProperty();
+		HandleAnimationProperty();
+		AdvanceStartedAnimations();
 
-	UpdateProperties();
+		meta->scroll.Update();
 
-	// Do en extra pass over the animations and properties if the 'animation' property was just changed.
-	if (dirty_animation)
+		UpdateProperties(start_transitions);
+
+		// Do en extra pass over the animations and properties if the 'animation' property was just changed.
+		if (dirty_animation)
+		{
+			HandleAnimationProperty();
+			AdvanceStartedAnimations();
+			UpdateProperties(start_transitions);
+		}
+
+		if (continuous_update)
+			DirtyUpdate();
+	}
+
+	// Clean subtrees are skipped entirely. Subtrees which are not rendered keep their dirty flags, and are updated once
+	// they are revealed.
+	if (descendant_update_dirty)
 	{
-		HandleAnimationProperty();
-		AdvanceAnimations();
-		UpdateProperties();
+		if (!update_hidden && IsSubtreeHidden())
+		{
+			SetDescendantUpdateDeferred(true);
+			return;
+		}
+
+		descendant_update_dirty = false;
+
+		// Changes made while the descendants were not rendered are applied without transitions, as they were never seen.
+		const bool start_child_transitions = (start_transitions && !descendant_update_deferred);
+		SetDescendantUpdateDeferred(false);
+
+		for (size_t i = 0; i < children.size(); i++)
+		{
+			Element* child = children[i].get();
+			if (child->update_dirty || child->descendant_update_dirty)
+				child->UpdateElement(dp_ratio, update_hidden, start_child_transitions);
+		}
 	}
+}
+
+bool Element::IsSubtreeHidden() const
+{
+	// Hidden elements are skipped when building the stacking context, however, only documents are also taken out of the
+	// layout. Other hidden elements still need the properties of their descendants to be sized correctly.
+	if (meta->computed_values.display == Style::Display::None)
+		return true;
+
+	return (!visible && owner_document == this);
+}
+
+void Element::SetDescendantUpdateDeferred(bool deferred)
+{
+	if (descendant_update_deferred == deferred)
+		return;
+
+	descendant_update_deferred = deferred;
 
-	for (size_t i = 0; i < children.size(); i++)
-		children[i]->Update(dp_ratio);
+	// The context counts the deferred subtrees, so that computed values only need to be resolved on demand while any exist.
+	if (Context* context = GetContext())
+		context->num_deferred_updates += (deferred ? 1 : -1);
 }
 
+void Element::UpdateHiddenProperties(const Element* hidden_ancestor)
+{
+	// Ancestors are updated first, as their values may be inherited.
+	if (parent != hidden_ancestor)
+		parent->UpdateHiddenProperties(hidden_ancestor);
 
-void Element::UpdateProperties()
+	// Only the properties are updated, the element is still updated as usual once revealed. Transitions are not started,
+	// as the changes were never rendered.
+	if (update_dirty)
+		UpdateProperties(false);
+}
+
+void Element::DirtyUpdate()
 {
-	meta->style.UpdateDefinition();
+	update_dirty = true;
+
+	for (Element* ancestor = parent; ancestor && !ancestor->descendant_update_dirty; ancestor = ancestor->parent)
+		ancestor->descendant_update_dirty = true;
+}
+
+void Element::EnableContinuousUpdate(bool enable)
+{
+	continuous_update = enable;
+	if (enable)
+		DirtyUpdate();
+}
+
+
+void Element::UpdateProperties(bool start_transitions)
+{
+	meta->style.UpdateDefinition(start_transitions);
 
 	if (meta->style.AnyPropertiesDirty())
 	{
@@ -1014,6 +1118,11 @@ ElementStyle* Element::GetStyle() const
 	return &meta->style;
 }
 
+ElementDataViews& Element::GetDataViews()
+{
+	return meta->data_views;
+}
+
 // Gets the document this element belongs to.
 ElementDocument* Element::GetOwnerDocument() const
 {
@@ -1118,6 +1227,9 @@ void Element::SetInnerRML(const String& rml)
 {
 	RMLUI_ZoneScopedC(0x6495ED);
 
+	// Coalesce the invalidations caused by the removed and inserted children.
+	ScopedMutationBatch mutation_batch(GetContext());
+
 	// Remove all DOM children.
 	while ((int) children.size() > num_non_dom_children)
 		RemoveChild(children.front().get());
@@ -1126,6 +1238,24 @@ void Element::SetInnerRML(const String& rml)
 		Factory::InstanceElementText(this, rml);
 }
 
+// Sets the markup and content of the element by reconciling it with the existing children.
+void Element::ReconcileInnerRML(const String& rml)
+{
+	RMLUI_ZoneScopedC(0x6495ED);
+
+	// Instance the new content into a detached element. Its elements are only adopted where our children differ.
+	ElementPtr source = Factory::InstanceElement(nullptr, "*", tag, XMLAttributes());
+	if (!source)
+		return;
+
+	if (!rml.empty())
+		Factory::InstanceElementText(source.get(), rml);
+
+	ScopedMutationBatch mutation_batch(GetContext());
+
+	ReconcileChildren(*source);
+}
+
 // Sets the current element as the focus object.
 bool Element::Focus()
 {
@@ -1288,9 +1418,7 @@ Element* Element::AppendChild(ElementPtr child, bool dom_element)
 		num_non_dom_children++;
 	}
 
-	Element* ancestor = child_ptr;
-	for (int i = 0; i <= ChildNotifyLevels && ancestor; i++, ancestor = ancestor->GetParentNode())
-		ancestor->OnChildAdd(child_ptr);
+	child_ptr->NotifyChildAdd();
 
 	DirtyStackingContext();
 	DirtyStructure();
@@ -1337,9 +1465,7 @@ Element* Element::InsertBefore(ElementPtr child, Element* adjacent_element)
 
 		children.insert(children.begin() + child_index, std::move(child));
 
-		Element* ancestor = child_ptr;
-		for (int i = 0; i <= ChildNotifyLevels && ancestor; i++, ancestor = ancestor->GetParentNode())
-			ancestor->OnChildAdd(child_ptr);
+		child_ptr->NotifyChildAdd();
 
 		DirtyStackingContext();
 		DirtyStructure();
@@ -1375,9 +1501,7 @@ ElementPtr Element::ReplaceChild(ElementPtr inserted_element, Element* replaced_
 	children.insert(insertion_point, std::move(inserted_element));
 	ElementPtr result = RemoveChild(replaced_element);
 
-	Element* ancestor = inserted_element_ptr;
-	for (int i = 0; i <= ChildNotifyLevels && ancestor; i++, ancestor = ancestor->GetParentNode())
-		ancestor->OnChildAdd(inserted_element_ptr);
+	inserted_element_ptr->NotifyChildAdd();
 
 	return result;
 }
@@ -1392,9 +1516,7 @@ ElementPtr Element::RemoveChild(Element* child)
 		// Add the element to the delete list
 		if (itr->get() == child)
 		{
-			Element* ancestor = child;
-			for (int i = 0; i <= ChildNotifyLevels && ancestor; i++, ancestor = ancestor->GetParentNode())
-				ancestor->OnChildRemove(child);
+			child->NotifyChildRemove();
 
 			if (child_index >= children.size() - num_non_dom_children)
 				num_non_dom_children--;
@@ -1777,6 +1899,7 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 	if (changed_properties.Contains(PropertyId::Transition))
 	{
 		dirty_transition = true;
+		DirtyUpdate();
 	}
 }
 
@@ -1790,6 +1913,12 @@ void Element::OnChildRemove(Element* child)
 {
 }
 
+// Regenerates the decorators, which may depend on the dimensions of the loaded texture.
+void Element::OnTextureLoad()
+{
+	meta->decoration.DirtyDecorators();
+}
+
 // Forces a re-layout of this element, and any other children required.
 void Element::DirtyLayout()
 {
@@ -1866,8 +1995,33 @@ void Element::ProcessDefaultAction(Event& event)
 	}
 }
 
-const Style::ComputedValues& Element::GetComputedValues() const
+const Style::ComputedValues& Element::GetComputedValues()
 {
+	// The context update skips the descendants of elements which are not rendered, resolve their pending styles on
+	// demand instead. The ancestors are only searched while the context has skipped any such descendants.
+	Context* context = GetContext();
+	if (context && context->num_deferred_updates > 0)
+	{
+		// Hidden subtrees may be nested, the outermost one determines which ancestors may be outdated. Only update if
+		// this element or any of its ancestors below it have changed.
+		const Element* hidden_ancestor = nullptr;
+		bool dirty = update_dirty;
+		bool update_hidden = false;
+
+		for (const Element* ancestor = parent; ancestor; ancestor = ancestor->parent)
+		{
+			if (ancestor->IsSubtreeHidden())
+			{
+				hidden_ancestor = ancestor;
+				update_hidden = dirty;
+			}
+			dirty |= ancestor->update_dirty;
+		}
+
+		if (hidden_ancestor && update_hidden)
+			UpdateHiddenProperties(hidden_ancestor);
+	}
+
 	return meta->computed_values;
 }
 
@@ -1918,6 +2072,14 @@ void Element::SetOwnerDocument(ElementDocument* document)
 		if (owner_document != document)
 		{
 			owner_document = document;
+
+			// We are attaching to a document, possibly also to a context.
+			if (document)
+			{
+				if (Context* context = document->GetContext())
+					context->OnElementAttach(this);
+			}
+
 			for (ElementPtr& child : children)
 				child->SetOwnerDocument(document);
 		}
@@ -1950,6 +2112,9 @@ void Element::SetParent(Element* _parent)
 	if (transform_state || (parent && parent->transform_state))
 		DirtyTransformState(true, true);
 
+	// The listeners of our new ancestors apply to us and our descendants.
+	meta->event_dispatcher.UpdateListenerMask();
+
 	SetOwnerDocument(parent ? parent->GetOwnerDocument() : nullptr);
 }
 
@@ -2086,6 +2251,18 @@ void Element::BuildStackingContext(ElementList* new_stacking_context)
 
 void Element::DirtyStackingContext()
 {
+	// Defer the ancestor walk until the end of the mutation batch, if any.
+	Context* context = GetContext();
+	if (context && context->mutation_batch_depth > 0)
+	{
+		if (!batch_stacking_context_pending)
+		{
+			batch_stacking_context_pending = true;
+			context->batch_stacking_context_elements.push_back(GetObserverPtr());
+		}
+		return;
+	}
+
 	// The first ancestor of ours that doesn't have an automatic z-index is the ancestor that is establishing our local
 	// stacking context.
 	Element* stacking_context_parent = this;
@@ -2100,6 +2277,7 @@ void Element::DirtyStackingContext()
 void Element::DirtyStructure()
 {
 	structure_dirty = true;
+	DirtyUpdate();
 }
 
 void Element::UpdateStructure()
@@ -2113,6 +2291,278 @@ void Element::UpdateStructure()
 	}
 }
 
+bool Element::ReconcileElement(Element& source)
+{
+	RMLUI_ASSERT(tag == source.tag && instancer == source.instancer);
+
+	if (ElementText* text_element = rmlui_dynamic_cast<ElementText*>(this))
+	{
+		ElementText* source_text_element = rmlui_dynamic_cast<ElementText*>(&source);
+		if (!source_text_element)
+			return false;
+
+		if (text_element->GetText() != source_text_element->GetText())
+			text_element->SetText(source_text_element->GetText());
+
+		return true;
+	}
+
+	// Custom elements may manage their own children, thus we only patch them if their content is unchanged.
+	const bool generic_element = (instancer == Factory::GetElementInstancer("*"));
+	if (!generic_element && !EqualChildren(source))
+		return false;
+
+	if (!ReconcileAttributes(source.attributes))
+		return false;
+
+	if (generic_element)
+		ReconcileChildren(source);
+
+	return true;
+}
+
+bool Element::ReconcileAttributes(const ElementAttributes& source_attributes)
+{
+	ElementAttributes changed_attributes;
+
+	for (auto& pair : source_attributes)
+	{
+		auto it = attributes.find(pair.first);
+		if (it == attributes.end() || it->second != pair.second)
+			changed_attributes.emplace(pair.first, pair.second);
+	}
+
+	// Removed attributes are signalled with an empty value, as in RemoveAttribute().
+	for (auto& pair : attributes)
+	{
+		if (source_attributes.find(pair.first) == source_attributes.end())
+			changed_attributes.emplace(pair.first, Variant());
+	}
+
+	if (changed_attributes.empty())
+		return true;
+
+	// Event listeners are bound from the attributes during instancing, they cannot be patched.
+	for (auto& pair : changed_attributes)
+	{
+		if (ElementUtilities::IsEventAttribute(pair.first))
+			return false;
+	}
+
+	// The inline style only adds properties when changed, remove the ones declared by the old value first.
+	auto it_style = changed_attributes.find("style");
+	if (it_style != changed_attributes.end())
+	{
+		auto it_old_style = attributes.find("style");
+		if (it_old_style != attributes.end())
+		{
+			PropertyDictionary properties;
+			StyleSheetParser parser;
+			parser.ParseProperties(properties, it_old_style->second.Get<String>());
+
+			for (auto& property : properties.GetProperties())
+				meta->style.RemoveProperty(property.first);
+		}
+	}
+
+	for (auto& pair : changed_attributes)
+	{
+		if (pair.second.GetType() == Variant::NONE)
+			attributes.erase(pair.first);
+		else
+			attributes[pair.first] = pair.second;
+	}
+
+	OnAttributeChange(changed_attributes);
+
+	return true;
+}
+
+bool Element::EqualChildren(const Element& source) const
+{
+	// Non-DOM children are included, as custom elements may move their content there.
+	const int num_children = (int)children.size();
+	if (num_children != (int)source.children.size())
+		return false;
+
+	for (int i = 0; i < num_children; i++)
+	{
+		const Element* child = children[i].get();
+		const Element* source_child = source.children[i].get();
+
+		if (child->tag != source_child->tag || child->attributes.size() != source_child->attributes.size())
+			return false;
+
+		for (auto& pair : source_child->attributes)
+		{
+			auto it = child->attributes.find(pair.first);
+			if (it == child->attributes.end() || it->second != pair.second)
+				return false;
+		}
+
+		const ElementText* text_child = rmlui_dynamic_cast<const ElementText*>(child);
+		const ElementText* source_text_child = rmlui_dynamic_cast<const ElementText*>(source_child);
+		if ((text_child != nullptr) != (source_text_child != nullptr) || (text_child && text_child->GetText() != source_text_child->GetText()))
+			return false;
+
+		if (!child->EqualChildren(*source_child))
+			return false;
+	}
+
+	return true;
+}
+
+void Element::ReconcileChildren(Element& source)
+{
+	const int num_old = GetNumChildren();
+	const int num_new = source.GetNumChildren();
+
+	// Children with a 'key' attribute are matched by key, the others by their position among the unkeyed children.
+	// Children sharing a key are matched in order. The candidates are listed in reverse, so that the next one to be
+	// matched is at the back.
+	UnorderedMap< String, std::vector< int > > keyed_old_children;
+	std::vector< int > unkeyed_old_children;
+
+	for (int i = num_old - 1; i >= 0; i--)
+	{
+		String key = children[i]->GetAttribute< String >("key", String());
+		if (key.empty())
+			unkeyed_old_children.push_back(i);
+		else
+			keyed_old_children[std::move(key)].push_back(i);
+	}
+
+	std::vector< int > matched_old_index(num_new, -1);
+	std::vector< bool > old_child_matched(num_old, false);
+
+	for (int i = 0; i < num_new; i++)
+	{
+		Element* new_child = source.children[i].get();
+
+		std::vector< int >* candidates = &unkeyed_old_children;
+		String key = new_child->GetAttribute< String >("key", String());
+		if (!key.empty())
+		{
+			auto it = keyed_old_children.find(key);
+			candidates = (it != keyed_old_children.end() ? &it->second : nullptr);
+		}
+
+		if (!candidates || candidates->empty())
+			continue;
+
+		const int old_index = candidates->back();
+		candidates->pop_back();
+
+		Element* old_child = children[old_index].get();
+		if (old_child->tag == new_child->tag && old_child->instancer == new_child->instancer && old_child->ReconcileElement(*new_child))
+		{
+			matched_old_index[i] = old_index;
+			old_child_matched[old_index] = true;
+		}
+	}
+
+	bool structure_changed = false;
+
+	// Remove the old children without a match, and find the position of the remaining ones.
+	std::vector< int > remaining_index(num_old, -1);
+	int num_remaining = 0;
+	for (int i = 0; i < num_old; i++)
+	{
+		if (old_child_matched[i])
+			remaining_index[i] = num_remaining++;
+	}
+
+	for (int i = num_old - 1; i >= 0; i--)
+	{
+		if (!old_child_matched[i])
+		{
+			RemoveChild(children[i].get());
+			structure_changed = true;
+		}
+	}
+
+	// Build the new list of DOM children, adopting the source children which were not matched.
+	OwnedElementList dom_children;
+	dom_children.reserve(num_new);
+	ElementList adopted_children;
+	int num_placed = 0;
+
+	for (int i = 0; i < num_new; i++)
+	{
+		if (matched_old_index[i] >= 0)
+		{
+			const int index = remaining_index[matched_old_index[i]];
+			if (index != num_placed)
+				structure_changed = true;
+
+			dom_children.push_back(std::move(children[index]));
+			num_placed++;
+		}
+		else
+		{
+			ElementPtr& new_child = source.children[i];
+			new_child->SetParent(nullptr);
+			adopted_children.push_back(new_child.get());
+			dom_children.push_back(std::move(new_child));
+			structure_changed = true;
+		}
+	}
+
+	RMLUI_ASSERT(num_placed == num_remaining);
+	children.erase(children.begin(), children.begin() + num_remaining);
+	children.insert(children.begin(), std::make_move_iterator(dom_children.begin()), std::make_move_iterator(dom_children.end()));
+
+	source.children.erase(std::remove(source.children.begin(), source.children.end(), nullptr), source.children.end());
+
+	for (Element* child : adopted_children)
+	{
+		child->SetParent(this);
+		child->NotifyChildAdd();
+	}
+
+	if (structure_changed)
+	{
+		DirtyStackingContext();
+		DirtyStructure();
+		DirtyLayout();
+	}
+}
+
+void Element::NotifyChildAdd()
+{
+	Context* context = GetContext();
+	if (context && context->mutation_batch_depth > 0)
+	{
+		if (!batch_child_add_pending)
+		{
+			batch_child_add_pending = true;
+			context->batch_added_elements.push_back(GetObserverPtr());
+		}
+		return;
+	}
+
+	// Any pending notification from an earlier batch is superseded by this one.
+	batch_child_add_pending = false;
+
+	Element* ancestor = this;
+	for (int i = 0; i <= ChildNotifyLevels && ancestor; i++, ancestor = ancestor->GetParentNode())
+		ancestor->OnChildAdd(this);
+}
+
+void Element::NotifyChildRemove()
+{
+	// The element was added and removed again during a mutation batch, neither change needs to be announced.
+	if (batch_child_add_pending)
+	{
+		batch_child_add_pending = false;
+		return;
+	}
+
+	Element* ancestor = this;
+	for (int i = 0; i <= ChildNotifyLevels && ancestor; i++, ancestor = ancestor->GetParentNode())
+		ancestor->OnChildRemove(this);
+}
+
 
 bool Element::Animate(const String & property_name, const Property & target_value, float duration, Tween tween, int num_iterations, bool alternate_direction, float delay, const Property* start_value)
 {
@@ -2192,6 +2642,10 @@ ElementAnimationList::iterator Element::StartAnimation(PropertyId property_id, c
 		animations.erase(it);
 		it = animations.end();
 	}
+	else
+	{
+		ScheduleAnimations();
+	}
 
 	return it;
 }
@@ -2251,7 +2705,10 @@ bool Element::StartTransition(const Transition & transition, const Property& sta
 	bool result = it->AddKey(duration, target_value, *this, transition.tween, true);
 
 	if (result)
+	{
 		SetProperty(transition.id, start_value);
+		ScheduleAnimations();
+	}
 	else
 		animations.erase(it);
 
@@ -2369,17 +2826,38 @@ void Element::HandleAnimationProperty()
 	}
 }
 
-void Element::AdvanceAnimations()
+void Element::ScheduleAnimations()
 {
-	if (!animations.empty())
+	animations_started = true;
+
+	if (animated_element_index < 0)
 	{
-		double time = Clock::GetElapsedTime();
+		if (Context* context = GetContext())
+			context->ScheduleAnimations(this);
+	}
+}
 
+void Element::AdvanceStartedAnimations()
+{
+	// Animations are started at the current time, thus they are advanced from a new sample of the clock.
+	if (animations_started)
+		AdvanceAnimations(Clock::GetElapsedTime());
+}
+
+void Element::AdvanceAnimations(double time)
+{
+	animations_started = false;
+
+	if (!animations.empty())
+	{
 		for (auto& animation : animations)
 		{
 			Property property = animation.UpdateAndGetProperty(time, *this);
 			if (property.unit != Property::UNKNOWN)
-				SetProperty(animation.GetPropertyId(), property);
+			{
+				if (!ApplyAnimatedRenderProperty(animation.GetPropertyId(), property))
+					SetProperty(animation.GetPropertyId(), property);
+			}
 		}
 
 		// Move all completed animations to the end of the list
@@ -2414,6 +2892,52 @@ void Element::AdvanceAnimations()
 
 
 
+bool Element::ApplyAnimatedRenderProperty(PropertyId id, const Property& property)
+{
+	if (id == PropertyId::Transform)
+	{
+		if (!meta->style.SetPropertyWithoutDirty(id, property))
+			return false;
+
+		// Only the transform state needs to be updated, the geometry and layout are unaffected.
+		meta->computed_values.transform = property.Get<TransformPtr>();
+		DirtyTransformState(false, true);
+		return true;
+	}
+	else if (id == PropertyId::Opacity)
+	{
+		if (!meta->style.SetPropertyWithoutDirty(id, property))
+			return false;
+
+		UpdateComputedOpacity(property.Get<float>());
+		return true;
+	}
+
+	return false;
+}
+
+void Element::UpdateComputedOpacity(float opacity)
+{
+	if (meta->computed_values.opacity == opacity)
+		return;
+
+	meta->computed_values.opacity = opacity;
+
+	static const PropertyIdSet opacity_changed = []() {
+		PropertyIdSet set;
+		set.Insert(PropertyId::Opacity);
+		return set;
+	}();
+	OnPropertyChange(opacity_changed);
+
+	// Opacity is inherited, except by the elements defining their own opacity.
+	for (ElementPtr& child : children)
+	{
+		if (!child->meta->style.GetLocalProperty(PropertyId::Opacity))
+			child->UpdateComputedOpacity(opacity);
+	}
+}
+
 void Element::DirtyTransformState(bool perspective_dirty, bool transform_dirty)
 {
 	dirty_perspective |= perspective_dirty;
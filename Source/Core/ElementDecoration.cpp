@@ -70,6 +70,15 @@ bool ElementDecoration::ReloadDecorators()
 // Loads a single decorator and adds it to the list of loaded decorators for this element.
 int ElementDecoration::LoadDecorator(SharedPtr<const Decorator> decorator)
 {
+	// The decorator is generated again once its textures have been loaded asynchronously, as it may depend on their dimensions.
+	RenderInterface* render_interface = element->GetRenderInterface();
+	for (int i = 0; i < decorator->GetNumTextures(); i++)
+	{
+		const Texture* texture = decorator->GetTexture(i);
+		if (texture && texture->IsLoading(render_interface))
+			texture->AddLoadListener(element);
+	}
+
 	DecoratorHandle element_decorator;
 	element_decorator.decorator_data = decorator->GenerateElementData(element);
 	element_decorator.decorator = std::move(decorator);
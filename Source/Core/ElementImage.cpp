@@ -71,6 +71,10 @@ bool ElementImage::GetIntrinsicDimensions(Vector2f& _dimensions)
 	else
 		dimensions.y = (float)texture.GetDimensions(GetRenderInterface()).y;
 
+	// If the texture is loaded asynchronously, its dimensions may only be known once loaded.
+	if (texture.IsLoading(GetRenderInterface()))
+		texture.AddLoadListener(this);
+
 	// Return the calculated dimensions. If this changes the size of the element, it will result in
 	// a call to 'onresize' below which will regenerate the geometry.
 	_dimensions = dimensions;
@@ -143,6 +147,21 @@ void ElementImage::OnResize()
 	GenerateGeometry();
 }
 
+// Updates the layout if the intrinsic dimensions changed with the loaded texture, and regenerates the geometry.
+void ElementImage::OnTextureLoad()
+{
+	Element::OnTextureLoad();
+
+	const Vector2f old_dimensions = dimensions;
+	Vector2f new_dimensions;
+	GetIntrinsicDimensions(new_dimensions);
+
+	if (new_dimensions != old_dimensions)
+		DirtyLayout();
+
+	geometry_dirty = true;
+}
+
 void ElementImage::GenerateGeometry()
 {
 	// Release the old geometry before specifying the new vertices.
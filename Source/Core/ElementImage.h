@@ -93,6 +93,9 @@ protected:
 	/// @param[in] changed_properties The properties changed on the element.
 	void OnPropertyChange(const PropertyIdSet& changed_properties) override;
 
+	/// Updates the image once its texture has been loaded asynchronously.
+	void OnTextureLoad() override;
+
 private:
 	// Generates the element's geometry.
 	void GenerateGeometry();
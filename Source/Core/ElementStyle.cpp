@@ -165,7 +165,7 @@ void ElementStyle::TransitionPropertyChanges(Element* element, PropertyIdSet& pr
 	}
 }
 	
-void ElementStyle::UpdateDefinition()
+void ElementStyle::UpdateDefinition(bool start_transitions)
 {
 	if (definition_dirty)
 	{
@@ -205,7 +205,8 @@ void ElementStyle::UpdateDefinition()
 				}
 
 				// Transition changed properties if transition property is set
-				TransitionPropertyChanges(element, changed_properties, inline_properties, definition.get(), new_definition.get());
+				if (start_transitions)
+					TransitionPropertyChanges(element, changed_properties, inline_properties, definition.get(), new_definition.get());
 			}
 
 			definition = new_definition;
@@ -303,6 +304,17 @@ String ElementStyle::GetClassNames() const
 
 // Sets a local property override on the element to a pre-parsed value.
 bool ElementStyle::SetProperty(PropertyId id, const Property& property)
+{
+	if (!SetPropertyWithoutDirty(id, property))
+		return false;
+
+	DirtyProperty(id);
+
+	return true;
+}
+
+// Sets a local property override on the element, leaving the computed value for the caller to update.
+bool ElementStyle::SetPropertyWithoutDirty(PropertyId id, const Property& property)
 {
 	Property new_property = property;
 
@@ -311,7 +323,6 @@ bool ElementStyle::SetProperty(PropertyId id, const Property& property)
 		return false;
 
 	inline_properties.SetProperty(id, new_property);
-	DirtyProperty(id);
 
 	return true;
 }
@@ -433,11 +444,13 @@ float ElementStyle::ResolveLength(const Property* property, RelativeTarget relat
 void ElementStyle::DirtyDefinition()
 {
 	definition_dirty = true;
+	element->DirtyUpdate();
 }
 
 void ElementStyle::DirtyInheritedProperties()
 {
 	dirty_properties |= StyleSheetSpecification::GetRegisteredInheritedProperties();
+	element->DirtyUpdate();
 }
 
 void ElementStyle::DirtyChildDefinitions()
@@ -496,12 +509,14 @@ PropertiesIterator ElementStyle::Iterate() const {
 void ElementStyle::DirtyProperty(PropertyId id)
 {
 	dirty_properties.Insert(id);
+	element->DirtyUpdate();
 }
 
 // Sets a list of properties as dirty.
 void ElementStyle::DirtyProperties(const PropertyIdSet& properties)
 {
 	dirty_properties |= properties;
+	element->DirtyUpdate();
 }
 
 PropertyIdSet ElementStyle::ComputeValues(Style::ComputedValues& values, const Style::ComputedValues* parent_values, const Style::ComputedValues* document_values, bool values_are_default_initialized, float dp_ratio)
@@ -897,7 +912,7 @@ PropertyIdSet ElementStyle::ComputeValues(Style::ComputedValues& values, const S
 		for (int i = 0; i < element->GetNumChildren(true); i++)
 		{
 			auto child = element->GetChild(i);
-			child->GetStyle()->dirty_properties |= dirty_inherited_properties;
+			child->GetStyle()->DirtyProperties(dirty_inherited_properties);
 		}
 	}
 	
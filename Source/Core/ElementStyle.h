@@ -57,7 +57,8 @@ public:
 	const ElementDefinition* GetDefinition() const;
 	
 	/// Update this definition if required
-	void UpdateDefinition();
+	/// @param[in] start_transitions False to switch the definition without transitioning the changed properties.
+	void UpdateDefinition(bool start_transitions = true);
 
 	/// Sets or removes a pseudo-class on the element.
 	/// @param[in] pseudo_class The pseudo class to activate or deactivate.
@@ -89,6 +90,11 @@ public:
 	/// @param[in] name The name of the new property.
 	/// @param[in] property The parsed property to set.
 	bool SetProperty(PropertyId id, const Property& property);
+	/// Sets a local property override on the element without dirtying the property. The caller is responsible for
+	/// updating the computed value of the property.
+	/// @param[in] name The name of the new property.
+	/// @param[in] property The parsed property to set.
+	bool SetPropertyWithoutDirty(PropertyId id, const Property& property);
 	/// Removes a local property override on the element; its value will revert to that defined in
 	/// the style sheet.
 	/// @param[in] name The name of the local property definition to remove.
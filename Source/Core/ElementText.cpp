@@ -27,6 +27,7 @@
  */
 
 #include "../../Include/RmlUi/Core/ElementText.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
 
 namespace Rml {
 namespace Core {
@@ -39,5 +40,22 @@ ElementText::~ElementText()
 {
 }
 
+bool ElementText::GenerateCharacterLine(std::vector< Character >& line, int& line_length, float& line_width, int line_begin, float maximum_line_width, float right_spacing_width, bool trim_whitespace_prefix, bool decode_escape_characters)
+{
+	String line_string;
+	bool result = GenerateLine(line_string, line_length, line_width, line_begin, maximum_line_width, right_spacing_width, trim_whitespace_prefix, decode_escape_characters);
+
+	line.clear();
+	for (auto it = StringIteratorU8(line_string); it; ++it)
+		line.push_back(*it);
+
+	return result;
+}
+
+void ElementText::AddCharacterLine(const Vector2f& line_position, const std::vector< Character >& line)
+{
+	AddLine(line_position, StringUtilities::ToUTF8(line.data(), (int)line.size()));
+}
+
 }
 }
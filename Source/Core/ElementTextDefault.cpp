@@ -38,12 +38,15 @@
 #include "../../Include/RmlUi/Core/GeometryUtilities.h"
 #include "../../Include/RmlUi/Core/Property.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
+#include <algorithm>
 
 namespace Rml {
 namespace Core {
 
-static bool BuildToken(String& token, const char*& token_begin, const char* string_end, bool first_token, bool collapse_white_space, bool break_at_endline, Style::TextTransform text_transformation, bool decode_escape_characters);
-static bool LastToken(const char* token_begin, const char* string_end, bool collapse_white_space, bool break_at_endline);
+static bool IsWhitespace(Character character)
+{
+	return character == Character('\r') || character == Character('\n') || character == Character(' ') || character == Character('\t');
+}
 
 ElementTextDefault::ElementTextDefault(const String& tag) : ElementText(tag), colour(255, 255, 255), decoration(this)
 {
@@ -57,6 +60,16 @@ ElementTextDefault::ElementTextDefault(const String& tag) : ElementText(tag), co
 	font_effects_handle = 0;
 	font_effects_dirty = true;
 	font_handle_version = 0;
+
+	character_offsets.push_back(0);
+
+	layout_characters_dirty = true;
+	layout_font_face_handle = 0;
+	layout_font_version = 0;
+	layout_break_at_endline = false;
+	layout_text_transform = Style::TextTransform::None;
+	layout_decode_escape_characters = false;
+	layout_character_advances = true;
 }
 
 ElementTextDefault::~ElementTextDefault()
@@ -69,6 +82,18 @@ void ElementTextDefault::SetText(const String& _text)
 	{
 		text = _text;
 
+		// Decode the text once, all layout and generation of the text works on the decoded characters.
+		characters.clear();
+		character_offsets.clear();
+		for (auto it = StringIteratorU8(text); it; ++it)
+		{
+			characters.push_back(*it);
+			character_offsets.push_back((int)it.Offset());
+		}
+		character_offsets.push_back((int)text.size());
+
+		layout_characters_dirty = true;
+
 		if (dirty_layout_on_change)
 			DirtyLayout();
 	}
@@ -154,11 +179,13 @@ bool ElementTextDefault::GenerateToken(float& token_width, int line_begin)
 {
 	RMLUI_ZoneScoped;
 
-	// Bail if we don't have a valid font face.
+	token_width = 0;
+
+	// Bail if we don't have a valid font face, or there is no text left to generate a token from.
 	FontFaceHandle font_face_handle = GetFontFaceHandle();
 	if (font_face_handle == 0 ||
 		line_begin >= (int) text.size())
-		return 0;
+		return true;
 
 	// Determine how we are processing white-space while formatting the text.
 	using namespace Style;
@@ -171,17 +198,29 @@ bool ElementTextDefault::GenerateToken(float& token_width, int line_begin)
 							white_space_property == WhiteSpace::Prewrap ||
 							white_space_property == WhiteSpace::Preline;
 
-	const char* token_begin = text.c_str() + line_begin;
-	String token;
+	UpdateLayoutCharacters(font_face_handle, break_at_endline, computed.text_transform, true);
+
+	int token_begin = GetCharacterIndex(line_begin);
+	if (token_begin >= (int)characters.size())
+		return true;
 
-	BuildToken(token, token_begin, text.c_str() + text.size(), true, collapse_white_space, break_at_endline, computed.text_transform, true);
-	token_width = (float) GetFontEngineInterface()->GetStringWidth(font_face_handle, token);
+	int width = 0;
+	BuildToken(token_characters, width, token_begin, Character::Null, true, collapse_white_space, break_at_endline);
+	token_width = (float) width;
 
-	return LastToken(token_begin, text.c_str() + text.size(), collapse_white_space, break_at_endline);
+	return LastToken(token_begin, collapse_white_space, break_at_endline);
 }
 
 // Generates a line of text rendered from this element
 bool ElementTextDefault::GenerateLine(String& line, int& line_length, float& line_width, int line_begin, float maximum_line_width, float right_spacing_width, bool trim_whitespace_prefix, bool decode_escape_characters)
+{
+	bool result = GenerateCharacterLine(line_characters, line_length, line_width, line_begin, maximum_line_width, right_spacing_width, trim_whitespace_prefix, decode_escape_characters);
+	line = StringUtilities::ToUTF8(line_characters.data(), (int)line_characters.size());
+	return result;
+}
+
+// Generates a line of text rendered from this element as code points.
+bool ElementTextDefault::GenerateCharacterLine(std::vector< Character >& line, int& line_length, float& line_width, int line_begin, float maximum_line_width, float right_spacing_width, bool trim_whitespace_prefix, bool decode_escape_characters)
 {
 	RMLUI_ZoneScoped;
 
@@ -214,29 +253,31 @@ bool ElementTextDefault::GenerateLine(String& line, int& line_length, float& lin
 	// Determine what (if any) text transformation we are putting the characters through.
 	TextTransform text_transform_property = computed.text_transform;
 
+	UpdateLayoutCharacters(font_face_handle, break_at_endline, text_transform_property, decode_escape_characters);
+
 	// Starting at the line_begin character, we generate sections of the text (we'll call them tokens) depending on the
 	// white-space parsing parameters. Each section is then appended to the line if it can fit. If not, or if an
 	// endline is found (and we're processing them), then the line is ended. kthxbai!
-	const char* token_begin = text.c_str() + line_begin;
-	const char* string_end = text.c_str() + text.size();
-	while (token_begin != string_end)
+
+	int token_begin = GetCharacterIndex(line_begin);
+	const int num_characters = (int)characters.size();
+	while (token_begin < num_characters)
 	{
-		String token;
-		const char* next_token_begin = token_begin;
+		int next_token_begin = token_begin;
 		Character previous_codepoint = Character::Null;
 		if (!line.empty())
-			previous_codepoint = StringUtilities::ToCharacter(StringUtilities::SeekBackwardUTF8(&line.back(), line.data()));
+			previous_codepoint = line.back();
 
 		// Generate the next token and determine its pixel-length.
-		bool break_line = BuildToken(token, next_token_begin, string_end, line.empty() && trim_whitespace_prefix, collapse_white_space, break_at_endline, text_transform_property, decode_escape_characters);
-		int token_width = GetFontEngineInterface()->GetStringWidth(font_face_handle, token, previous_codepoint);
+		int token_width = 0;
+		bool break_line = BuildToken(token_characters, token_width, next_token_begin, previous_codepoint, line.empty() && trim_whitespace_prefix, collapse_white_space, break_at_endline);
 
 		// If we're breaking to fit a line box, check if the token can fit on the line before we add it.
 		if (break_at_line)
 		{
 			if (!line.empty() &&
 				(line_width + token_width > maximum_line_width ||
-				 (LastToken(next_token_begin, string_end, collapse_white_space, break_at_endline) && line_width + token_width > maximum_line_width - right_spacing_width)))
+				 (LastToken(next_token_begin, collapse_white_space, break_at_endline) && line_width + token_width > maximum_line_width - right_spacing_width)))
 			{
 				return false;
 			}
@@ -244,8 +285,8 @@ bool ElementTextDefault::GenerateLine(String& line, int& line_length, float& lin
 
 		// The token can fit on the end of the line, so add it onto the end and increment our width and length
 		// counters.
-		line += token;
-		line_length += (int)(next_token_begin - token_begin);
+		line.insert(line.end(), token_characters.begin(), token_characters.end());
+		line_length += character_offsets[next_token_begin] - character_offsets[token_begin];
 		line_width += token_width;
 
 		// Break out of the loop if an endline was forced.
@@ -272,6 +313,16 @@ void ElementTextDefault::ClearLines()
 
 // Adds a new line into the text element.
 void ElementTextDefault::AddLine(const Vector2f& line_position, const String& line)
+{
+	line_characters.clear();
+	for (auto it = StringIteratorU8(line); it; ++it)
+		line_characters.push_back(*it);
+
+	AddCharacterLine(line_position, line_characters);
+}
+
+// Adds a new line given as code points into the text element.
+void ElementTextDefault::AddCharacterLine(const Vector2f& line_position, const std::vector< Character >& line)
 {
 	FontFaceHandle font_face_handle = GetFontFaceHandle();
 
@@ -282,7 +333,8 @@ void ElementTextDefault::AddLine(const Vector2f& line_position, const String& li
 		UpdateFontEffects();
 
 	Vector2f baseline_position = line_position + Vector2f(0.0f, (float)GetFontEngineInterface()->GetLineHeight(font_face_handle) - GetFontEngineInterface()->GetBaseline(font_face_handle));
-	lines.push_back(Line(line, baseline_position));
+	lines.push_back(Line(baseline_position));
+	lines.back().characters = line;
 
 	geometry_dirty = true;
 }
@@ -355,8 +407,23 @@ void ElementTextDefault::OnPropertyChange(const PropertyIdSet& changed_propertie
 	}
 	else if (colour_changed)
 	{
-		// Force the geometry to be regenerated.
-		geometry_dirty = true;
+		const FontEffects* font_effects = computed.font_effect.get();
+		if (!geometry_dirty && !font_effects_dirty && (!font_effects || font_effects->list.empty()))
+		{
+			// Without font effects, all the text geometry is generated in the text colour. Re-colour it in place instead
+			// of regenerating it, which makes animating the colour or opacity of text cheap.
+			for (Geometry& layer_geometry : geometry)
+			{
+				for (Vertex& vertex : layer_geometry.GetVertices())
+					vertex.colour = colour;
+				layer_geometry.Release();
+			}
+		}
+		else
+		{
+			// Force the geometry to be regenerated.
+			geometry_dirty = true;
+		}
 
 		// Re-colour the decoration geometry.
 		std::vector< Vertex >& vertices = decoration.GetVertices();
@@ -420,7 +487,7 @@ void ElementTextDefault::GenerateGeometry(const FontFaceHandle font_face_handle)
 
 void ElementTextDefault::GenerateGeometry(const FontFaceHandle font_face_handle, Line& line)
 {
-	line.width = GetFontEngineInterface()->GenerateString(font_face_handle, font_effects_handle, line.text, line.position, colour, geometry);
+	line.width = GetFontEngineInterface()->GenerateCharacterString(font_face_handle, font_effects_handle, line.characters.data(), (int)line.characters.size(), line.position, colour, geometry);
 	for (size_t i = 0; i < geometry.size(); ++i)
 		geometry[i].SetHostElement(this);
 
@@ -436,87 +503,169 @@ void ElementTextDefault::GenerateLineDecoration(const FontFaceHandle font_face_h
 	GeometryUtilities::GenerateLine(font_face_handle, &decoration, line.position, line.width, decoration_property, colour);
 }
 
-static bool BuildToken(String& token, const char*& token_begin, const char* string_end, bool first_token, bool collapse_white_space, bool break_at_endline, Style::TextTransform text_transformation, bool decode_escape_characters)
+// Processes and measures the decoded text for the given font and text processing, unless already done.
+void ElementTextDefault::UpdateLayoutCharacters(FontFaceHandle font_face_handle, bool break_at_endline, Style::TextTransform text_transform, bool decode_escape_characters)
 {
-	RMLUI_ASSERT(token_begin != string_end);
+	// The advances change with the font version, such as when fallback faces are added.
+	const int font_version = GetFontEngineInterface()->GetVersion(font_face_handle);
+
+	if (!layout_characters_dirty &&
+		layout_font_face_handle == font_face_handle &&
+		layout_font_version == font_version &&
+		layout_break_at_endline == break_at_endline &&
+		layout_text_transform == text_transform &&
+		layout_decode_escape_characters == decode_escape_characters)
+		return;
 
-	token.reserve(string_end - token_begin + token.size());
+	RMLUI_ZoneScoped;
 
-	// Check what the first character of the token is; all we need to know is if it is white-space or not.
-	bool parsing_white_space = StringUtilities::IsWhitespace(*token_begin);
+	layout_characters_dirty = false;
+	layout_font_face_handle = font_face_handle;
+	layout_font_version = font_version;
+	layout_break_at_endline = break_at_endline;
+	layout_text_transform = text_transform;
+	layout_decode_escape_characters = decode_escape_characters;
 
-	// Loop through the string from the token's beginning until we find an end to the token. This can occur in various
-	// places, depending on the white-space processing;
-	//  - at the end of a section of non-white-space characters,
-	//  - at the end of a section of white-space characters, if we're not collapsing white-space,
-	//  - at an endline token, if we're breaking on endlines.
-	while (token_begin != string_end)
+	static const struct { const char* code; Character character; } escape_codes[] = {
+		{ "lt;", Character('<') }, { "gt;", Character('>') }, { "amp;", Character('&') }, { "quot;", Character('"') }, { "nbsp;", Character(' ') }
+	};
+
+	const int num_characters = (int)characters.size();
+	layout_characters.resize(num_characters);
+
+	// The processed characters in the order they are visited, measured together below.
+	std::vector< Character > layout_string;
+	layout_string.reserve(num_characters);
+
+	Character previous = Character::Null;
+
+	for (int i = 0; i < num_characters; )
 	{
+		Character character = characters[i];
+		int length = 1;
 		bool force_non_whitespace = false;
-		char character = *token_begin;
-
-		const char* escape_begin = token_begin;
 
-		// Check for an ampersand; if we find one, we've got an HTML escaped character.
-		if (decode_escape_characters && character == '&')
+		// Check for an ampersand; if we find one, we've got an HTML escaped character. If it is a non-breaking space,
+		// prevent it being picked up as whitespace. If it is not recognised, print it like normal text.
+		if (decode_escape_characters && character == Character('&'))
 		{
-			// Find the terminating ';'.
-			while (token_begin != string_end &&
-				   *token_begin != ';')
-				++token_begin;
-
-			// If we couldn't find the ';', print the token like normal text.
-			if (token_begin == string_end)
+			for (const auto& escape : escape_codes)
 			{
-				token_begin = escape_begin;
-			}
-			// We could find a ';', parse the escape code. If the escape code is recognised, set the parsed character
-			// to the appropriate one. If it is a non-breaking space, prevent it being picked up as whitespace. If it
-			// is not recognised, print the token like normal text.
-			else
-			{
-				String escape_code(escape_begin + 1, token_begin);
-
-				if (escape_code == "lt")
-					character = '<';
-				else if (escape_code == "gt")
-					character = '>';
-				else if (escape_code == "amp")
-					character = '&';
-				else if (escape_code == "quot")
-					character = '"';
-				else if (escape_code == "nbsp")
+				int code_length = 0;
+				while (escape.code[code_length] && i + 1 + code_length < num_characters &&
+					characters[i + 1 + code_length] == Character(escape.code[code_length]))
+					++code_length;
+
+				if (!escape.code[code_length])
 				{
-					character = ' ';
-					force_non_whitespace = true;
+					character = escape.character;
+					length = 1 + code_length;
+					force_non_whitespace = (escape.character == Character(' '));
+					break;
 				}
-				else
-					token_begin = escape_begin;
 			}
 		}
 
+		const bool white_space = !force_non_whitespace && IsWhitespace(character);
+
+		// White-space is appended as a single space, except for endlines that we're breaking on.
+		if (white_space)
+		{
+			if (!(break_at_endline && character == Character('\n')))
+				character = Character(' ');
+		}
+		else if (text_transform == Style::TextTransform::Uppercase)
+		{
+			if (character >= Character('a') && character <= Character('z'))
+				character = Character((char32_t)character + ('A' - 'a'));
+		}
+		else if (text_transform == Style::TextTransform::Lowercase)
+		{
+			if (character >= Character('A') && character <= Character('Z'))
+				character = Character((char32_t)character - ('A' - 'a'));
+		}
+
+		layout_characters[i] = LayoutCharacter{ character, previous, 0, length, white_space };
+		layout_string.push_back(character);
+
+		previous = character;
+		i += length;
+	}
+
+	// Measure the whole text at once, lines and tokens then add up the advances of their characters.
+	std::vector< int > advances(layout_string.size());
+	layout_character_advances = GetFontEngineInterface()->GetCharacterAdvances(font_face_handle, layout_string.data(), (int)layout_string.size(), advances.data());
+
+	for (int i = 0, j = 0; i < num_characters; i += layout_characters[i].length, ++j)
+		layout_characters[i].advance = advances[j];
+}
+
+bool ElementTextDefault::BuildToken(std::vector< Character >& token, int& token_width, int& token_begin, Character prior_character, bool first_token, bool collapse_white_space, bool break_at_endline)
+{
+	const int num_characters = (int)characters.size();
+	RMLUI_ASSERT(token_begin < num_characters);
+
+	token.clear();
+	token_width = 0;
+
+	// Without character advances from the font engine, the token is measured as a whole once built.
+	const Character token_prior_character = prior_character;
+	auto EndToken = [&](bool forced_line_break) {
+		if (!layout_character_advances)
+			token_width = GetFontEngineInterface()->GetStringWidth(layout_font_face_handle, StringUtilities::ToUTF8(token.data(), (int)token.size()), token_prior_character);
+		return forced_line_break;
+	};
+
+	// Appends the processed character at the given index to the token. Its measured advance is used unless it was
+	// measured following a different character, such as when white-space has been collapsed.
+	auto AppendCharacter = [&](int index) {
+		const LayoutCharacter& layout_character = layout_characters[index];
+
+		if (layout_character.previous == prior_character)
+		{
+			token_width += layout_character.advance;
+		}
+		else if (layout_character_advances)
+		{
+			int advance = 0;
+			GetFontEngineInterface()->GetCharacterAdvances(layout_font_face_handle, &layout_character.character, 1, &advance, prior_character);
+			token_width += advance;
+		}
+
+		token.push_back(layout_character.character);
+		prior_character = layout_character.character;
+	};
+
+	// Check what the first character of the token is; all we need to know is if it is white-space or not.
+	const int white_space_begin = token_begin;
+	bool parsing_white_space = layout_characters[token_begin].white_space;
+
+	// Loop through the string from the token's beginning until we find an end to the token. This can occur in various
+	// places, depending on the white-space processing;
+	//  - at the end of a section of non-white-space characters,
+	//  - at the end of a section of white-space characters, if we're not collapsing white-space,
+	//  - at an endline token, if we're breaking on endlines.
+	while (token_begin < num_characters)
+	{
+		const LayoutCharacter& layout_character = layout_characters[token_begin];
+
 		// Check for an endline token; if we're breaking on endlines and we find one, then return true to indicate a
 		// forced break.
 		if (break_at_endline &&
-			character == '\n')
+			layout_character.character == Character('\n'))
 		{
-			token += '\n';
-			token_begin++;
-			return true;
+			AppendCharacter(token_begin);
+			token_begin += layout_character.length;
+			return EndToken(true);
 		}
 
 		// If we've transitioned from white-space characters to non-white-space characters, or vice-versa, then check
 		// if should terminate the token; if we're not collapsing white-space, then yes (as sections of white-space are
 		// non-breaking), otherwise only if we've transitioned from characters to white-space.
-		bool white_space = !force_non_whitespace && StringUtilities::IsWhitespace(character);
-		if (white_space != parsing_white_space)
+		if (layout_character.white_space != parsing_white_space)
 		{
 			if (!collapse_white_space)
-			{
-				// Restore pointer to the beginning of the escaped token, if we processed an escape code.
-				token_begin = escape_begin;
-				return false;
-			}
+				return EndToken(false);
 
 			// We're collapsing white-space; we only tokenise words, not white-space, so we're only done tokenising
 			// once we've begun parsing non-white-space and then found white-space.
@@ -525,73 +674,58 @@ static bool BuildToken(String& token, const char*& token_begin, const char* stri
 				// However, if we are the last non-whitespace character in the string, and there are trailing
 				// whitespace characters after this token, then we need to append a single space to the end of this
 				// token.
-				if (token_begin != string_end &&
-					LastToken(token_begin, string_end, collapse_white_space, break_at_endline))
-					token += ' ';
+				if (LastToken(token_begin, collapse_white_space, break_at_endline))
+					AppendCharacter(token_begin);
 
-				return false;
+				return EndToken(false);
 			}
 
 			// We've transitioned from white-space to non-white-space, so we append a single white-space character.
 			if (!first_token)
-				token += ' ';
+				AppendCharacter(white_space_begin);
 
 			parsing_white_space = false;
 		}
 
 		// If the current character is white-space, we'll append a space character to the token if we're not collapsing
 		// sections of white-space.
-		if (white_space)
-		{
-			if (!collapse_white_space)
-				token += ' ';
-		}
-		else
-		{
-			if (text_transformation == Style::TextTransform::Uppercase)
-			{
-				if (character >= 'a' && character <= 'z')
-					character += ('A' - 'a');
-			}
-			else if (text_transformation == Style::TextTransform::Lowercase)
-			{
-				if (character >= 'A' && character <= 'Z')
-					character -= ('A' - 'a');
-			}
-
-			token += character;
-		}
+		if (!layout_character.white_space || !collapse_white_space)
+			AppendCharacter(token_begin);
 
-		++token_begin;
+		token_begin += layout_character.length;
 	}
 
-	return false;
+	return EndToken(false);
 }
 
-static bool LastToken(const char* token_begin, const char* string_end, bool collapse_white_space, bool break_at_endline)
+bool ElementTextDefault::LastToken(int token_begin, bool collapse_white_space, bool break_at_endline) const
 {
-	bool last_token = (token_begin == string_end);
+	const int num_characters = (int)characters.size();
+
+	bool last_token = (token_begin >= num_characters);
 	if (collapse_white_space &&
 		!last_token)
 	{
 		last_token = true;
-		const char* character = token_begin;
 
-		while (character != string_end)
+		for (int i = token_begin; i < num_characters; ++i)
 		{
-			if (!StringUtilities::IsWhitespace(*character) ||
-				(break_at_endline && *character == '\n'))
+			if (!IsWhitespace(characters[i]) ||
+				(break_at_endline && characters[i] == Character('\n')))
 			{
 				last_token = false;
 				break;
 			}
-
-			character++;
 		}
 	}
 
 	return last_token;
 }
 
+int ElementTextDefault::GetCharacterIndex(int byte_offset) const
+{
+	return (int)(std::lower_bound(character_offsets.begin(), character_offsets.end(), byte_offset) - character_offsets.begin());
+}
+
 }
 }
@@ -69,6 +69,8 @@ public:
 	/// @param[in] decode_escape_characters Decode escaped characters such as &amp; into &.
 	/// @return True if the line reached the end of the element's text, false if not.
 	bool GenerateLine(String& line, int& line_length, float& line_width, int line_begin, float maximum_line_width, float right_spacing_width, bool trim_whitespace_prefix, bool decode_escape_characters) override;
+	/// Generates a line of text rendered from this element as code points, without encoding the line.
+	bool GenerateCharacterLine(std::vector< Character >& line, int& line_length, float& line_width, int line_begin, float maximum_line_width, float right_spacing_width, bool trim_whitespace_prefix, bool decode_escape_characters) override;
 
 	/// Clears all lines of generated text and prepares the element for generating new lines.
 	void ClearLines() override;
@@ -76,6 +78,10 @@ public:
 	/// @param[in] line_position The position of this line, as an offset from the first line.
 	/// @param[in] line The contents of the line..
 	void AddLine(const Vector2f& line_position, const String& line) override;
+	/// Adds a new line given as code points into the text element.
+	/// @param[in] line_position The position of this line, as an offset from the first line.
+	/// @param[in] line The code points of the line.
+	void AddCharacterLine(const Vector2f& line_position, const std::vector< Character >& line) override;
 
 	/// Prevents the element from dirtying its document's layout when its text is changed.
 	void SuppressAutoLayout() override;
@@ -94,12 +100,36 @@ private:
 	// Used to store the position and length of each line we have geometry for.
 	struct Line
 	{
-		Line(const String& text, const Vector2f& position) : text(text), position(position), width(0) {}
-		String text;
+		Line(const Vector2f& position) : position(position), width(0) {}
+		std::vector< Character > characters;
 		Vector2f position;
 		int width;
 	};
 
+	// A character of the text as laid out, stored at the index of the source character it starts at.
+	struct LayoutCharacter
+	{
+		// The character appended to a line, after white-space, escape and text-transform processing.
+		Character character;
+		// The character assumed to precede this one when its advance was measured.
+		Character previous;
+		// The advance of the character, including the kerning between it and the previous character.
+		int advance;
+		// The number of source characters making up this character, more than one for escaped characters.
+		int length;
+		bool white_space;
+	};
+
+	// Processes and measures the decoded text for the given font and text processing, unless already done.
+	void UpdateLayoutCharacters(FontFaceHandle font_face_handle, bool break_at_endline, Style::TextTransform text_transform, bool decode_escape_characters);
+	// Builds the next token of text starting at the given character index, advancing the index past it. Returns true
+	// if the token ends with a forced line break.
+	bool BuildToken(std::vector< Character >& token, int& token_width, int& token_begin, Character prior_character, bool first_token, bool collapse_white_space, bool break_at_endline);
+	// Returns true if no more tokens will be generated from the given character index.
+	bool LastToken(int token_begin, bool collapse_white_space, bool break_at_endline) const;
+	// Returns the index of the character starting at the given byte offset into the text.
+	int GetCharacterIndex(int byte_offset) const;
+
 	// Clears and regenerates all of the text's geometry.
 	void GenerateGeometry(const FontFaceHandle font_face_handle);
 	// Generates the geometry for a single line of text.
@@ -109,6 +139,25 @@ private:
 
 	String text;
 
+	// The text decoded once into characters, and the byte offset of each character in the text plus the end offset.
+	std::vector< Character > characters;
+	std::vector< int > character_offsets;
+
+	// The processed and measured characters, valid for the font and text processing they were generated with.
+	std::vector< LayoutCharacter > layout_characters;
+	bool layout_characters_dirty;
+	FontFaceHandle layout_font_face_handle;
+	int layout_font_version;
+	bool layout_break_at_endline;
+	Style::TextTransform layout_text_transform;
+	bool layout_decode_escape_characters;
+	// False if the font engine doesn't provide character advances, tokens are then measured as a whole.
+	bool layout_character_advances;
+
+	// Scratch buffers used while generating and adding lines.
+	std::vector< Character > line_characters;
+	std::vector< Character > token_characters;
+
 	typedef std::vector< Line > LineList;
 	LineList lines;
 
@@ -166,14 +166,26 @@ void ElementUtilities::BindEventAttributes(Element* element)
 	// Check for and instance the on* events
 	for (const auto& pair: element->GetAttributes())
 	{
-		if (pair.first.size() > 2 && pair.first[0] == 'o' && pair.first[1] == 'n')
+		String event_type;
+		if (IsEventAttribute(pair.first, &event_type))
 		{
 			EventListener* listener = Factory::InstanceEventListener(pair.second.Get<String>(), element);
 			if (listener)
-				element->AddEventListener(pair.first.substr(2), listener, false);
+				element->AddEventListener(event_type, listener, false);
 		}
 	}
 }
+
+bool ElementUtilities::IsEventAttribute(const String& name, String* event_type)
+{
+	if (name.size() <= 2 || name[0] != 'o' || name[1] != 'n')
+		return false;
+
+	if (event_type)
+		*event_type = name.substr(2);
+
+	return true;
+}
 	
 // Generates the clipping region for an element.
 bool ElementUtilities::GetClippingRegion(Vector2i& clip_origin, Vector2i& clip_dimensions, Element* element)
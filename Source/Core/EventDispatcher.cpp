@@ -75,6 +75,14 @@ void EventDispatcher::AttachEvent(EventId id, EventListener* listener, bool in_c
 	{
 		// No existing entry found, add it to the end of the (id, phase) range
 		listeners.emplace(it, entry);
+
+		const EventMask mask = GetEventMask(id);
+		if (!(listener_mask & mask))
+		{
+			listener_mask |= mask;
+			UpdateListenerMask();
+		}
+
 		listener->OnAttach(element);
 	}
 }
@@ -93,6 +101,7 @@ void EventDispatcher::DetachEvent(EventId id, EventListener* listener, bool in_c
 	{
 		// We found our listener, remove it
 		listeners.erase(it);
+		RebuildListenerMask();
 		listener->OnDetach(element);
 	}
 }
@@ -104,11 +113,52 @@ void EventDispatcher::DetachAllEvents()
 		event.listener->OnDetach(element);
 
 	listeners.clear();
+	RebuildListenerMask();
 
 	for (int i = 0; i < element->GetNumChildren(true); ++i)
 		element->GetChild(i)->GetEventDispatcher()->DetachAllEvents();
 }
 
+void EventDispatcher::UpdateListenerMask()
+{
+	Element* parent = element->GetParentNode();
+	const EventMask new_chain_listener_mask = listener_mask | (parent ? parent->GetEventDispatcher()->chain_listener_mask : 0);
+
+	// The masks of the descendants only depend on their ancestors, thus we can stop when the mask is unchanged.
+	if (new_chain_listener_mask == chain_listener_mask)
+		return;
+
+	chain_listener_mask = new_chain_listener_mask;
+
+	for (int i = 0; i < element->GetNumChildren(true); ++i)
+		element->GetChild(i)->GetEventDispatcher()->UpdateListenerMask();
+}
+
+bool EventDispatcher::HasListenersInChain(EventId id) const
+{
+	return (chain_listener_mask & GetEventMask(id)) != 0;
+}
+
+EventDispatcher::EventMask EventDispatcher::GetEventMask(EventId id)
+{
+	constexpr int num_bits = 8 * sizeof(EventMask);
+	const int bit = std::min((int)id, num_bits - 1);
+	return EventMask(1) << bit;
+}
+
+void EventDispatcher::RebuildListenerMask()
+{
+	EventMask new_listener_mask = 0;
+	for (const auto& entry : listeners)
+		new_listener_mask |= GetEventMask(entry.id);
+
+	if (new_listener_mask != listener_mask)
+	{
+		listener_mask = new_listener_mask;
+		UpdateListenerMask();
+	}
+}
+
 /*
 	CollectedListener
 
@@ -137,15 +187,60 @@ struct CollectedListener {
 	}
 };
 
+/*
+	DispatchBuffers
+
+	The containers used while dispatching an event are reused between dispatches to avoid allocations. Listeners may
+	dispatch new events, thus a separate set of buffers is used for each nesting level of dispatches. The buffers are
+	kept per thread, as contexts may be updated on separate threads.
+*/
+struct DispatchBuffers {
+	std::vector<CollectedListener> listeners;
+	std::vector<CollectedListener> bubble_listeners;
+	std::vector<ObserverPtr<Element>> default_action_elements;
+};
+
+static thread_local std::vector<UniquePtr<DispatchBuffers>> dispatch_buffers;
+static thread_local size_t dispatch_depth = 0;
+
+class ScopedDispatchBuffers : NonCopyMoveable {
+public:
+	ScopedDispatchBuffers()
+	{
+		if (dispatch_buffers.size() <= dispatch_depth)
+			dispatch_buffers.push_back(std::make_unique<DispatchBuffers>());
+		buffers = dispatch_buffers[dispatch_depth].get();
+		dispatch_depth += 1;
+	}
+	~ScopedDispatchBuffers()
+	{
+		// Release the observers, but keep the capacity for the next dispatch.
+		buffers->listeners.clear();
+		buffers->bubble_listeners.clear();
+		buffers->default_action_elements.clear();
+		dispatch_depth -= 1;
+	}
+
+	DispatchBuffers* buffers;
+};
+
 
 bool EventDispatcher::DispatchEvent(Element* target_element, const EventId id, const String& type, const Dictionary& parameters, const bool interruptible, const bool bubbles, const DefaultActionPhase default_action_phase)
 {
 	RMLUI_ASSERTMSG(!((int)default_action_phase & (int)EventPhase::Capture), "We assume here that the default action phases cannot include capture phase.");
 
-	std::vector<CollectedListener> listeners;
-	std::vector<ObserverPtr<Element>> default_action_elements;
+	ScopedDispatchBuffers scoped_buffers;
+	std::vector<CollectedListener>& listeners = scoped_buffers.buffers->listeners;
+	std::vector<CollectedListener>& bubble_listeners = scoped_buffers.buffers->bubble_listeners;
+	std::vector<ObserverPtr<Element>>& default_action_elements = scoped_buffers.buffers->default_action_elements;
+
+	// Skip the dispatch entirely when nothing would respond to the event.
+	const bool has_listeners = target_element->GetEventDispatcher()->HasListenersInChain(id);
+	if (!has_listeners && default_action_phase == DefaultActionPhase::None)
+		return true;
 
 	const EventPhase phases_to_execute = EventPhase((int)EventPhase::Capture | (int)EventPhase::Target | (bubbles ? (int)EventPhase::Bubble : 0));
+	const EventMask event_mask = GetEventMask(id);
 	
 	// Walk the DOM tree from target to root, collecting all possible listeners and elements with default actions in the process.
 	int dom_distance_from_target = 0;
@@ -153,7 +248,8 @@ bool EventDispatcher::DispatchEvent(Element* target_element, const EventId id, c
 	while (walk_element)
 	{
 		EventDispatcher* dispatcher = walk_element->GetEventDispatcher();
-		dispatcher->CollectListeners(dom_distance_from_target, id, phases_to_execute, listeners);
+		if (dispatcher->listener_mask & event_mask)
+			dispatcher->CollectListeners(dom_distance_from_target, id, phases_to_execute, listeners, bubble_listeners);
 
 		if(dom_distance_from_target == 0)
 		{
@@ -169,11 +265,23 @@ bool EventDispatcher::DispatchEvent(Element* target_element, const EventId id, c
 		dom_distance_from_target += 1;
 	}
 
-	if (listeners.empty() && default_action_elements.empty())
+	if (listeners.empty() && bubble_listeners.empty() && default_action_elements.empty())
 		return true;
 
-	// Use stable_sort so that the order of the listeners in a given element is maintained.
-	std::stable_sort(listeners.begin(), listeners.end());
+	// The capture listeners were collected from the target towards the root, but execute from the root towards the target.
+	// Reverse the order of the elements, while maintaining the order of the listeners in a given element.
+	std::reverse(listeners.begin(), listeners.end());
+	for (auto it_begin = listeners.begin(); it_begin != listeners.end();)
+	{
+		const int sort = it_begin->sort;
+		auto it_end = std::find_if(it_begin, listeners.end(), [sort](const CollectedListener& listener) { return listener.sort != sort; });
+		std::reverse(it_begin, it_end);
+		it_begin = it_end;
+	}
+
+	// The target and bubble listeners execute after the capture listeners, already in the order they were collected. In
+	// particular, the order of the target listeners is kept as is, regardless of the phase they were attached to.
+	listeners.insert(listeners.end(), bubble_listeners.begin(), bubble_listeners.end());
 
 	// Instance event
 	EventPtr event = Factory::InstanceEvent(target_element, id, type, parameters, interruptible);
@@ -228,7 +336,7 @@ bool EventDispatcher::DispatchEvent(Element* target_element, const EventId id, c
 }
 
 
-void EventDispatcher::CollectListeners(int dom_distance_from_target, const EventId event_id, const EventPhase event_executes_in_phases, std::vector<CollectedListener>& collect_listeners)
+void EventDispatcher::CollectListeners(int dom_distance_from_target, const EventId event_id, const EventPhase event_executes_in_phases, std::vector<CollectedListener>& collect_capture_listeners, std::vector<CollectedListener>& collect_listeners)
 {
 	// Find all the entries with a matching id, given that listeners are sorted by id first.
 	Listeners::iterator begin, end;
@@ -238,7 +346,9 @@ void EventDispatcher::CollectListeners(int dom_distance_from_target, const Event
 
 	if (in_target_phase)
 	{
-		// Listeners always attach to target phase, but make sure the event can actually execute in target phase.
+		// Listeners always attach to target phase, but make sure the event can actually execute in target phase. They
+		// execute in the order of the entries, thus listeners attached to the bubble phase run before those attached to
+		// the capture phase, each in the order they were attached.
 		if ((int)event_executes_in_phases & (int)EventPhase::Target)
 		{
 			for (auto it = begin; it != end; ++it)
@@ -253,7 +363,12 @@ void EventDispatcher::CollectListeners(int dom_distance_from_target, const Event
 			// Listeners will either attach to capture or bubble phase, make sure the event can execute in the same phase.
 			const EventPhase listener_executes_in_phase = (it->in_capture_phase ? EventPhase::Capture : EventPhase::Bubble);
 			if ((int)event_executes_in_phases & (int)listener_executes_in_phase)
-				collect_listeners.emplace_back(element, it->listener, dom_distance_from_target, it->in_capture_phase);
+			{
+				if (it->in_capture_phase)
+					collect_capture_listeners.emplace_back(element, it->listener, dom_distance_from_target, true);
+				else
+					collect_listeners.emplace_back(element, it->listener, dom_distance_from_target, false);
+			}
 		}
 	}
 }
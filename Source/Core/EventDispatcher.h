@@ -79,6 +79,11 @@ public:
 	/// Detaches all events from this dispatcher and all child dispatchers.
 	void DetachAllEvents();
 
+	/// Updates the mask of listened events inherited from the element's parent, must be called when the element changes parent.
+	void UpdateListenerMask();
+	/// Returns true if any listeners to the given event may be attached to the element or any of its ancestors.
+	bool HasListenersInChain(EventId id) const;
+
 	/// Dispatches the specified event.
 	/// @param[in] target_element The element to target
 	/// @param[in] id The id of the event
@@ -102,8 +107,21 @@ private:
 	typedef std::vector< EventListenerEntry > Listeners;
 	Listeners listeners;
 
+	// Each bit represents an event id with listeners attached, custom event ids share the last bit.
+	using EventMask = uint64_t;
+	// Events with listeners attached to this dispatcher.
+	EventMask listener_mask = 0;
+	// Events with listeners attached to this dispatcher or the dispatchers of any ancestor elements.
+	EventMask chain_listener_mask = 0;
+
+	static EventMask GetEventMask(EventId id);
+
+	// Recalculates the listener mask after listeners have been removed.
+	void RebuildListenerMask();
+
 	// Collect all the listeners from this dispatcher that are allowed to execute given the input arguments.
-	void CollectListeners(int dom_distance_from_target, EventId event_id, EventPhase phases_to_execute, std::vector<CollectedListener>& collect_listeners);
+	// Capture phase listeners are collected separately from the target and bubble phase listeners.
+	void CollectListeners(int dom_distance_from_target, EventId event_id, EventPhase phases_to_execute, std::vector<CollectedListener>& collect_capture_listeners, std::vector<CollectedListener>& collect_listeners);
 };
 
 
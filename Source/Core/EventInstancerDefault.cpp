@@ -32,6 +32,12 @@
 namespace Rml {
 namespace Core {
 
+// Released events are kept for reuse, so that dispatching events does not allocate once the list has warmed up. The
+// list is per thread, as contexts may be updated on separate threads. The number of events in flight at any time is
+// bounded by the nesting depth of dispatches, thus only a few events need to be kept.
+static constexpr size_t max_free_events = 16;
+static thread_local std::vector< UniquePtr<Event> > free_events;
+
 EventInstancerDefault::EventInstancerDefault()
 {
 }
@@ -42,13 +48,24 @@ EventInstancerDefault::~EventInstancerDefault()
 
 EventPtr EventInstancerDefault::InstanceEvent(Element* target, EventId id, const String& type, const Dictionary& parameters, bool interruptible)
 {
+	if (!free_events.empty())
+	{
+		Event* event = free_events.back().release();
+		free_events.pop_back();
+		event->Initialise(target, id, type, parameters, interruptible);
+		return EventPtr(event);
+	}
+
 	return EventPtr(new Event(target, id, type, parameters, interruptible));
 }
 
 // Releases an event instanced by this instancer.
 void EventInstancerDefault::ReleaseEvent(Event* event)
 {
-	delete event;
+	if (free_events.size() < max_free_events)
+		free_events.emplace_back(event);
+	else
+		delete event;
 }
 
 void EventInstancerDefault::Release()
@@ -28,22 +28,30 @@
 
 #include "EventSpecification.h"
 #include "../../Include/RmlUi/Core/ID.h"
+#include "Mutex.h"
+#include <deque>
 
 
 namespace Rml {
 namespace Core {
 
-// An EventId is an index into the specifications vector.
-static std::vector<EventSpecification> specifications = { { EventId::Invalid, "invalid", false, false, DefaultActionPhase::None } };
+// An EventId is an index into the specifications list. A deque is used so that references to the specifications remain
+// valid when new event types are inserted.
+static std::deque<EventSpecification> specifications = { { EventId::Invalid, "invalid", false, false, DefaultActionPhase::None } };
 
 // Reverse lookup map from event type to id.
 static UnorderedMap<String, EventId> type_lookup;
 
+// Guards the specifications, as custom event types may be inserted while other contexts are updated.
+static Mutex specifications_mutex;
+
 
 namespace EventSpecificationInterface {
 
 void Initialize()
 {
+	MutexLock lock(specifications_mutex);
+
 	// Must be specified in the same order as in EventId
 	specifications = {
 		//      id                 type      interruptible  bubbles     default_action
@@ -139,6 +147,7 @@ static EventSpecification& GetOrInsert(const String& event_type, bool interrupti
 
 const EventSpecification& Get(EventId id)
 {
+	MutexLock lock(specifications_mutex);
 	return GetMutable(id);
 }
 
@@ -149,20 +158,25 @@ const EventSpecification& GetOrInsert(const String& event_type)
 	constexpr bool bubbles = true;
 	constexpr DefaultActionPhase default_action_phase = DefaultActionPhase::None;
 
+	MutexLock lock(specifications_mutex);
 	return GetOrInsert(event_type, interruptible, bubbles, default_action_phase);
 }
 
 EventId GetIdOrInsert(const String& event_type)
 {
+	MutexLock lock(specifications_mutex);
+
 	auto it = type_lookup.find(event_type);
 	if (it != type_lookup.end())
 		return it->second;
 
-	return GetOrInsert(event_type).id;
+	return GetOrInsert(event_type, true, true, DefaultActionPhase::None).id;
 }
 
 EventId InsertOrReplaceCustom(const String& event_type, bool interruptible, bool bubbles, DefaultActionPhase default_action_phase)
 {
+	MutexLock lock(specifications_mutex);
+
 	const size_t size_before = specifications.size();
 	EventSpecification& specification = GetOrInsert(event_type, interruptible, bubbles, default_action_phase);
 	bool got_existing_entry = (size_before == specifications.size());
@@ -35,6 +35,7 @@ namespace Core {
 FontEffect::FontEffect() : colour(255, 255, 255)
 {
 	layer = Layer::Back;
+	fingerprint = 0;
 }
 
 FontEffect::~FontEffect()
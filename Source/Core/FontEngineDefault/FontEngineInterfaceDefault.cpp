@@ -29,10 +29,15 @@
 #include "FontProvider.h"
 #include "FontFaceHandleDefault.h"
 #include "FontEngineInterfaceDefault.h"
+#include "../Mutex.h"
 
 namespace Rml {
 namespace Core {
 
+// Font faces and their glyph layouts are shared between contexts. The metrics of a font face handle are fixed once it is
+// created, while any calls which may create or modify handles, layers and layouts must hold this lock.
+static Mutex font_engine_mutex;
+
 FontEngineInterfaceDefault::FontEngineInterfaceDefault()
 {
 	FontProvider::Initialise();
@@ -45,22 +50,26 @@ FontEngineInterfaceDefault::~FontEngineInterfaceDefault()
 
 bool FontEngineInterfaceDefault::LoadFontFace(const String& file_name, bool fallback_face)
 {
+	MutexLock lock(font_engine_mutex);
 	return FontProvider::LoadFontFace(file_name, fallback_face);
 }
 
 bool FontEngineInterfaceDefault::LoadFontFace(const byte* data, int data_size, const String& font_family, Style::FontStyle style, Style::FontWeight weight, bool fallback_face)
 {
+	MutexLock lock(font_engine_mutex);
 	return FontProvider::LoadFontFace(data, data_size, font_family, style, weight, fallback_face);
 }
 
 FontFaceHandle FontEngineInterfaceDefault::GetFontFaceHandle(const String& family, Style::FontStyle style, Style::FontWeight weight, int size)
 {
+	MutexLock lock(font_engine_mutex);
 	auto handle = FontProvider::GetFontFaceHandle(family, style, weight, size);
 	return reinterpret_cast<FontFaceHandle>(handle);
 }
 	
 FontEffectsHandle FontEngineInterfaceDefault::PrepareFontEffects(FontFaceHandle handle, const FontEffectList& font_effects)
 {
+	MutexLock lock(font_engine_mutex);
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault *>(handle);
 	return (FontEffectsHandle)handle_default->GenerateLayerConfiguration(font_effects);
 }
@@ -97,22 +106,50 @@ float FontEngineInterfaceDefault::GetUnderline(FontFaceHandle handle, float& thi
 
 int FontEngineInterfaceDefault::GetStringWidth(FontFaceHandle handle, const String& string, Character prior_character)
 {
+	MutexLock lock(font_engine_mutex);
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault *>(handle);
 	return handle_default->GetStringWidth(string, prior_character);
 }
 
+bool FontEngineInterfaceDefault::GetCharacterAdvances(FontFaceHandle handle, const Character* string, int num_characters, int* advances, Character prior_character)
+{
+	MutexLock lock(font_engine_mutex);
+	auto handle_default = reinterpret_cast<FontFaceHandleDefault *>(handle);
+	handle_default->GetCharacterAdvances(string, num_characters, advances, prior_character);
+	return true;
+}
+
 int FontEngineInterfaceDefault::GenerateString(FontFaceHandle handle, FontEffectsHandle font_effects_handle, const String& string,
 	const Vector2f& position, const Colourb& colour, GeometryList& geometry)
 {
+	MutexLock lock(font_engine_mutex);
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault *>(handle);
-	return handle_default->GenerateString(geometry, string, position, colour, (int)font_effects_handle);
+	int result = handle_default->GenerateString(geometry, string, position, colour, (int)font_effects_handle);
+	return result;
+}
+
+int FontEngineInterfaceDefault::GenerateCharacterString(FontFaceHandle handle, FontEffectsHandle font_effects_handle, const Character* string, int num_characters,
+	const Vector2f& position, const Colourb& colour, GeometryList& geometry)
+{
+	MutexLock lock(font_engine_mutex);
+	auto handle_default = reinterpret_cast<FontFaceHandleDefault *>(handle);
+	int result = handle_default->GenerateString(geometry, string, num_characters, position, colour, (int)font_effects_handle);
+	return result;
 }
 
 int FontEngineInterfaceDefault::GetVersion(FontFaceHandle handle)
 {
+	MutexLock lock(font_engine_mutex);
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault*>(handle);
 	return handle_default->GetVersion();
 }
 
+void FontEngineInterfaceDefault::ReleaseIdleResources()
+{
+	MutexLock lock(font_engine_mutex);
+	FontProvider::ReleaseIdleFontFaces();
+	FontProvider::SaveGlyphCaches();
+}
+
 }
 }
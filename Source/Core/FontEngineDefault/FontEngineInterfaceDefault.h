@@ -69,11 +69,20 @@ public:
 	/// Returns the width a string will take up if rendered with this handle.
 	int GetStringWidth(FontFaceHandle, const String& string, Character prior_character) override;
 
+	/// Retrieves the advance of each character of a string of code points.
+	bool GetCharacterAdvances(FontFaceHandle, const Character* string, int num_characters, int* advances, Character prior_character) override;
+
 	/// Generates the geometry required to render a single line of text.
 	int GenerateString(FontFaceHandle, FontEffectsHandle, const String& string, const Vector2f& position, const Colourb& colour, GeometryList& geometry) override;
 
+	/// Generates the geometry required to render a single line of text given as code points.
+	int GenerateCharacterString(FontFaceHandle, FontEffectsHandle, const Character* string, int num_characters, const Vector2f& position, const Colourb& colour, GeometryList& geometry) override;
+
 	/// Returns the current version of the font face.
 	int GetVersion(FontFaceHandle handle) override;
+
+	/// Releases the font data of faces loaded from files which have been idle, while over the font memory budget.
+	void ReleaseIdleResources() override;
 };
 
 }
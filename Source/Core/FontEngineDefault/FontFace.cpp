@@ -26,23 +26,60 @@
  *
  */
 
+#include "../../../Include/RmlUi/Core/Core.h"
+#include "../../../Include/RmlUi/Core/FileInterface.h"
 #include "../../../Include/RmlUi/Core/Log.h"
+#include "../../../Include/RmlUi/Core/SystemInterface.h"
 #include "FontFace.h"
 #include "FontFaceHandleDefault.h"
+#include "FontGlyphCache.h"
 #include "FreeTypeInterface.h"
 
 namespace Rml {
 namespace Core {
 
+// The time in seconds before loading a face from its file is attempted again after it failed.
+static constexpr double load_retry_interval = 5.0;
+
+#ifdef RMLUI_SCALED_FONT_GLYPHS
+// Returns the size at which glyphs are rasterized for rendering text of the given size. The reference sizes grow by 25%
+// each step, so that glyphs are never scaled down by more than that. Small sizes are always rasterized at their own size.
+static int GetReferenceSize(int size)
+{
+	constexpr int min_reference_size = 12;
+
+	int reference_size = min_reference_size;
+	if (size <= reference_size)
+		return size;
+
+	while (reference_size < size)
+		reference_size = (reference_size * 5 + 3) / 4;
+
+	return reference_size;
+}
+#endif
+
 FontFace::FontFace(FontFaceHandleFreetype _face, Style::FontStyle _style, Style::FontWeight _weight, bool _release_stream)
 {
 	style = _style;
 	weight = _weight;
 	face = _face;
+	has_kerning = FreeType::HasKerning(face);
 
 	release_stream = _release_stream;
 }
 
+FontFace::FontFace(const String& _file_name, Style::FontStyle _style, Style::FontWeight _weight, bool _has_kerning)
+{
+	style = _style;
+	weight = _weight;
+	face = 0;
+	has_kerning = _has_kerning;
+
+	file_name = _file_name;
+	release_stream = true;
+}
+
 FontFace::~FontFace()
 {
 	if (face) 
@@ -65,22 +102,39 @@ Style::FontWeight FontFace::GetWeight() const
 	return weight;
 }
 
+bool FontFace::HasKerning() const
+{
+	return has_kerning;
+}
+
 FontFaceHandleDefault* FontFace::GetHandle(int size) {
 	auto it = handles.find(size);
 	if (it != handles.end())
 		return it->second.get();
 
-	// See if this face has been released.
-	if (!face)
+	// Construct and initialise the new handle.
+	auto handle = std::make_unique<FontFaceHandleDefault>();
+	bool initialized = false;
+
+#ifdef RMLUI_SCALED_FONT_GLYPHS
+	// Render the handle using the glyphs of the handle at the reference size, if that is another size.
+	const int reference_size = GetReferenceSize(size);
+	if (reference_size != size)
 	{
-		Log::Message(Log::LT_WARNING, "Font face has been released, unable to generate new handle.");
-		return nullptr;
+		if (FontFaceHandleDefault* reference_handle = GetHandle(reference_size))
+			initialized = handle->Initialize(reference_handle, size);
 	}
+#endif
 
-	// Construct and initialise the new handle.
-	auto handle = std::make_unique<FontFaceHandleDefault>();
-	if (!handle->Initialize(face, size))
+	if (!initialized && !handle->Initialize(this, size, GetFontHash()))
 	{
+		// The face may be loaded on a later attempt, so only remember handles which failed for other reasons.
+		if (load_failed)
+		{
+			Log::Message(Log::LT_WARNING, "Font face could not be loaded, unable to generate new handle.");
+			return nullptr;
+		}
+
 		handles[size] = nullptr;
 		return nullptr;
 	}
@@ -93,6 +147,110 @@ FontFaceHandleDefault* FontFace::GetHandle(int size) {
 	return result;
 }
 
+FontFaceHandleFreetype FontFace::UseFreeTypeFace()
+{
+	used = true;
+
+	return LoadFreeTypeFace();
+}
+
+FontFaceHandleFreetype FontFace::LoadFreeTypeFace()
+{
+	if (face || file_name.empty())
+		return face;
+
+	const double current_time = GetSystemInterface()->GetElapsedTime();
+	if (load_failed && current_time - load_failed_time < load_retry_interval)
+		return 0;
+
+	load_failed = true;
+	load_failed_time = current_time;
+
+	FileInterface* file_interface = GetFileInterface();
+	FileHandle handle = file_interface->Open(file_name);
+
+	if (!handle)
+	{
+		Log::Message(Log::LT_ERROR, "Failed to load font face from %s, could not open file.", file_name.c_str());
+		return 0;
+	}
+
+	size_t length = file_interface->Length(handle);
+
+	byte* buffer = new byte[length];
+	file_interface->Read(buffer, length, handle);
+	file_interface->Close(handle);
+
+	face = FreeType::LoadFace(buffer, (int)length, file_name);
+
+	if (!face)
+	{
+		delete[] buffer;
+		return 0;
+	}
+
+	loaded_data_size = length;
+	load_failed = false;
+
+	return face;
+}
+
+void FontFace::ReleaseFreeTypeFace()
+{
+	if (!face || file_name.empty())
+		return;
+
+	FreeType::ReleaseFace(face, release_stream);
+	face = 0;
+	loaded_data_size = 0;
+}
+
+size_t FontFace::GetLoadedDataSize() const
+{
+	return loaded_data_size;
+}
+
+double FontFace::UpdateLastUsedTime(double current_time)
+{
+	if (used)
+	{
+		last_used_time = current_time;
+		used = false;
+	}
+
+	return last_used_time;
+}
+
+uint64_t FontFace::GetFontHash()
+{
+	if (!FontGlyphCache::IsEnabled())
+		return 0;
+
+	if (font_hash == 0)
+	{
+		FontFaceHandleFreetype ft_face = LoadFreeTypeFace();
+		if (!ft_face)
+			return 0;
+
+		const byte* data = nullptr;
+		size_t data_size = 0;
+		FreeType::GetFaceData(ft_face, data, data_size);
+
+		if (data && data_size > 0)
+			font_hash = FontGlyphCache::HashFontData(data, data_size);
+	}
+
+	return font_hash;
+}
+
+void FontFace::SaveGlyphCaches()
+{
+	for (auto& pair : handles)
+	{
+		if (pair.second)
+			pair.second->SaveGlyphCache();
+	}
+}
 
 }
 }
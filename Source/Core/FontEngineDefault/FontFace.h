@@ -45,17 +45,44 @@ class FontFace
 {
 public:
 	FontFace(FontFaceHandleFreetype face, Style::FontStyle style, Style::FontWeight weight, bool release_stream);
+	/// Constructs a face loaded from the given file when first used.
+	FontFace(const String& file_name, Style::FontStyle style, Style::FontWeight weight, bool has_kerning);
 	~FontFace();
 
 	Style::FontStyle GetStyle() const;
 	Style::FontWeight GetWeight() const;
+	/// Returns true if the face has kerning information, known without loading the face.
+	bool HasKerning() const;
 
 	/// Returns a handle for positioning and rendering this face at the given size.
 	/// @param[in] size The size of the desired handle, in points.
 	/// @return The font handle.
 	FontFaceHandleDefault* GetHandle(int size);
 
+	/// Returns the FreeType face for rasterizing glyphs or looking up kerning, loading it from its file first if
+	/// necessary. Marks the face as used, so that it is kept loaded while it is needed.
+	/// @return The FreeType face, or zero if it could not be loaded.
+	FontFaceHandleFreetype UseFreeTypeFace();
+
+	/// Releases the FreeType face and its font data if it was loaded from a file, it is loaded again when next used.
+	/// Handles of the face remain valid.
+	void ReleaseFreeTypeFace();
+	/// Returns the size of the font data loaded from the file of this face, or zero if it is not currently loaded.
+	size_t GetLoadedDataSize() const;
+	/// Returns the time the face was last used, updating it to the given time if the face has been used since the last call.
+	double UpdateLastUsedTime(double current_time);
+
+	/// Writes the glyph caches of the face's handles which generated new glyphs.
+	void SaveGlyphCaches();
+
 private:
+	// Returns the FreeType face, loading it from its file first if necessary. A face which failed to load is only
+	// tried again after a while, to avoid reading the file again for every glyph.
+	FontFaceHandleFreetype LoadFreeTypeFace();
+
+	// Returns the hash of the font data identifying this face in the glyph cache, or zero if the cache is disabled.
+	uint64_t GetFontHash();
+
 	Style::FontStyle style;
 	Style::FontWeight weight;
 
@@ -66,6 +93,19 @@ private:
 	HandleMap handles;
 
 	FontFaceHandleFreetype face;
+
+	// The file to load the face from when needed, or empty if the face is always loaded.
+	String file_name;
+	size_t loaded_data_size = 0;
+	bool load_failed = false;
+	double load_failed_time = 0;
+
+	bool has_kerning = false;
+
+	bool used = false;
+	double last_used_time = 0;
+
+	uint64_t font_hash = 0;
 };
 
 }
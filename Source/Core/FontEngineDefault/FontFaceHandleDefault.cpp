@@ -28,9 +28,10 @@
 
 #include "FontFaceHandleDefault.h"
 #include "../../../Include/RmlUi/Core/StringUtilities.h"
-#include "../TextureLayout.h"
+#include "FontFace.h"
 #include "FontProvider.h"
 #include "FontFaceLayer.h"
+#include "FontGlyphCache.h"
 #include "FreeTypeInterface.h"
 #include <algorithm>
 
@@ -41,7 +42,7 @@ FontFaceHandleDefault::FontFaceHandleDefault()
 {
 	base_layer = nullptr;
 	metrics = {};
-	ft_face = 0;
+	font_face = nullptr;
 }
 
 FontFaceHandleDefault::~FontFaceHandleDefault()
@@ -50,15 +51,34 @@ FontFaceHandleDefault::~FontFaceHandleDefault()
 	layers.clear();
 }
 
-bool FontFaceHandleDefault::Initialize(FontFaceHandleFreetype face, int font_size)
+bool FontFaceHandleDefault::Initialize(FontFace* face, int font_size, uint64_t font_hash)
 {
-	ft_face = face;
+	font_face = face;
+	has_kerning = face->HasKerning();
 
 	RMLUI_ASSERTMSG(layer_configurations.empty(), "Initialize must only be called once.");
 
-	if (!FreeType::InitialiseFaceHandle(ft_face, font_size, glyphs, metrics))
+	bool loaded_from_cache = false;
+	if (font_hash != 0)
 	{
-		return false;
+		glyph_cache = std::make_unique<FontGlyphCache>(font_hash, font_size);
+		loaded_from_cache = (glyph_cache->Load(glyphs, metrics) && metrics.size == font_size);
+	}
+
+	if (!loaded_from_cache)
+	{
+		glyphs.clear();
+		metrics = {};
+
+		FontFaceHandleFreetype ft_face = font_face->UseFreeTypeFace();
+		if (!ft_face || !FreeType::InitialiseFaceHandle(ft_face, font_size, glyphs, metrics))
+		{
+			glyph_cache.reset();
+			return false;
+		}
+
+		if (glyph_cache)
+			glyph_cache->SetDirty();
 	}
 
 	// Generate the default layer and layer configuration.
@@ -68,6 +88,27 @@ bool FontFaceHandleDefault::Initialize(FontFaceHandleFreetype face, int font_siz
 	return true;
 }
 
+bool FontFaceHandleDefault::Initialize(FontFaceHandleDefault* in_reference_handle, int font_size)
+{
+	RMLUI_ASSERTMSG(layer_configurations.empty() && !reference_handle, "Initialize must only be called once.");
+	RMLUI_ASSERT(in_reference_handle && !in_reference_handle->reference_handle);
+
+	reference_handle = in_reference_handle;
+	reference_scale = float(font_size) / float(reference_handle->metrics.size);
+
+	// The glyphs and layers are used directly from the reference handle, only the metrics are needed at this size.
+	const FontMetrics& reference_metrics = reference_handle->metrics;
+
+	metrics.size = font_size;
+	metrics.x_height = Math::RoundToInteger(reference_scale * float(reference_metrics.x_height));
+	metrics.line_height = Math::RoundToInteger(reference_scale * float(reference_metrics.line_height));
+	metrics.baseline = Math::RoundToInteger(reference_scale * float(reference_metrics.baseline));
+	metrics.underline_position = reference_scale * reference_metrics.underline_position;
+	metrics.underline_thickness = Math::Max(reference_scale * reference_metrics.underline_thickness, 1.0f);
+
+	return true;
+}
+
 // Returns the point size of this font face.
 int FontFaceHandleDefault::GetSize() const
 {
@@ -107,6 +148,9 @@ float FontFaceHandleDefault::GetUnderline(float& thickness) const
 // Returns the width a string will take up if rendered with this handle.
 int FontFaceHandleDefault::GetStringWidth(const String& string, Character prior_character)
 {
+	if (reference_handle)
+		return Math::RoundToInteger(reference_scale * float(reference_handle->GetStringWidth(string, prior_character)));
+
 	int width = 0;
 	for (auto it_string = StringIteratorU8(string); it_string; ++it_string)
 	{
@@ -128,9 +172,50 @@ int FontFaceHandleDefault::GetStringWidth(const String& string, Character prior_
 	return width;
 }
 
+void FontFaceHandleDefault::GetCharacterAdvances(const Character* string, int num_characters, int* advances, Character prior_character)
+{
+	if (reference_handle)
+	{
+		reference_handle->GetCharacterAdvances(string, num_characters, advances, prior_character);
+
+		// Scale the accumulated width rather than each advance, so that the advances add up to the scaled string width.
+		int width = 0;
+		int scaled_width = 0;
+		for (int i = 0; i < num_characters; ++i)
+		{
+			width += advances[i];
+			const int next_scaled_width = Math::RoundToInteger(reference_scale * float(width));
+			advances[i] = next_scaled_width - scaled_width;
+			scaled_width = next_scaled_width;
+		}
+		return;
+	}
+
+	for (int i = 0; i < num_characters; ++i)
+	{
+		Character character = string[i];
+		advances[i] = 0;
+
+		const FontGlyph* glyph = GetOrAppendGlyph(character);
+		if (!glyph)
+			continue;
+
+		// Adjust the advance for the kerning between this character and the previous one.
+		if (prior_character != Character::Null)
+			advances[i] += GetKerning(prior_character, character);
+		advances[i] += glyph->advance;
+
+		prior_character = character;
+	}
+}
+
 // Generates, if required, the layer configuration for a given array of font effects.
 int FontFaceHandleDefault::GenerateLayerConfiguration(const FontEffectList& font_effects)
 {
+	// The effects are applied to the glyphs of the reference handle, thus they are scaled along with them.
+	if (reference_handle)
+		return reference_handle->GenerateLayerConfiguration(font_effects);
+
 	if (font_effects.empty())
 		return 0;
 
@@ -193,14 +278,8 @@ int FontFaceHandleDefault::GenerateLayerConfiguration(const FontEffectList& font
 }
 
 // Generates the texture data for a layer (for the texture database).
-bool FontFaceHandleDefault::GenerateLayerTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, const FontEffect* font_effect, int texture_id, int handle_version) const
+bool FontFaceHandleDefault::GenerateLayerTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, const FontEffect* font_effect, int texture_id) const
 {
-	if (handle_version != version)
-	{
-		RMLUI_ERRORMSG("While generating font layer texture: Handle version mismatch in texture vs font-face.");
-		return false;
-	}
-
 	auto it = std::find_if(layers.begin(), layers.end(), [font_effect](const EffectLayerPair& pair) { return pair.font_effect == font_effect; });
 
 	if (it == layers.end())
@@ -209,18 +288,56 @@ bool FontFaceHandleDefault::GenerateLayerTexture(UniquePtr<const byte[]>& textur
 		return false;
 	}
 
-	return it->layer->GenerateTexture(texture_data, texture_dimensions, texture_id, glyphs);
+	return it->layer->GenerateTexture(texture_data, texture_dimensions, texture_id, this);
 }
 
 // Generates the geometry required to render a single line of text.
-int FontFaceHandleDefault::GenerateString(GeometryList& geometry, const String& string, const Vector2f& position, const Colourb& colour, int layer_configuration_index)
+int FontFaceHandleDefault::GenerateString(GeometryList& geometry, const String& string, const Vector2f& position, const Colourb& colour, int layer_configuration_index, float scale)
+{
+	string_characters.clear();
+	for (auto it_string = StringIteratorU8(string); it_string; ++it_string)
+		string_characters.push_back(*it_string);
+
+	return GenerateString(geometry, string_characters.data(), (int)string_characters.size(), position, colour, layer_configuration_index, scale);
+}
+
+// Generates the geometry required to render a single line of text given as code points.
+int FontFaceHandleDefault::GenerateString(GeometryList& geometry, const Character* string, int num_characters, const Vector2f& position, const Colourb& colour, int layer_configuration_index, float scale)
 {
+	if (reference_handle)
+		return reference_handle->GenerateString(geometry, string, num_characters, position, colour, layer_configuration_index, reference_scale);
+
 	int geometry_index = 0;
 	int line_width = 0;
 
 	RMLUI_ASSERT(layer_configuration_index >= 0);
 	RMLUI_ASSERT(layer_configuration_index < (int) layer_configurations.size());
 
+	// Look up the glyphs and lay them out once, shared by all the layers. This also appends any new glyphs before
+	// updating the layers, so that they are all placed in the layer textures.
+	glyph_positions.clear();
+	glyph_positions.reserve(num_characters);
+
+	Character prior_character = Character::Null;
+
+	for (int i = 0; i < num_characters; ++i)
+	{
+		Character character = string[i];
+
+		const FontGlyph* glyph = GetOrAppendGlyph(character);
+		if (!glyph)
+			continue;
+
+		// Adjust the cursor for the kerning between this character and the previous one.
+		if (prior_character != Character::Null)
+			line_width += GetKerning(prior_character, character);
+
+		glyph_positions.push_back(GlyphPosition{ character, line_width });
+
+		line_width += glyph->advance;
+		prior_character = character;
+	}
+
 	UpdateLayersOnDirty();
 
 	// Fetch the requested configuration and generate the geometry for each one.
@@ -254,29 +371,11 @@ int FontFaceHandleDefault::GenerateString(GeometryList& geometry, const String&
 		for (int i = 0; i < num_textures; ++i)
 			geometry[geometry_index + i].SetTexture(layer->GetTexture(i));
 
-		line_width = 0;
-		Character prior_character = Character::Null;
-
-		geometry[geometry_index].GetIndices().reserve(string.size() * 6);
-		geometry[geometry_index].GetVertices().reserve(string.size() * 4);
-
-		for (auto it_string = StringIteratorU8(string); it_string; ++it_string)
-		{
-			Character character = *it_string;
-
-			const FontGlyph* glyph = GetOrAppendGlyph(character);
-			if (!glyph)
-				continue;
-
-			// Adjust the cursor for the kerning between this character and the previous one.
-			if (prior_character != Character::Null)
-				line_width += GetKerning(prior_character, character);
-
-			layer->GenerateGeometry(&geometry[geometry_index], character, Vector2f(position.x + line_width, position.y), layer_colour);
+		geometry[geometry_index].GetIndices().reserve(glyph_positions.size() * 6);
+		geometry[geometry_index].GetVertices().reserve(glyph_positions.size() * 4);
 
-			line_width += glyph->advance;
-			prior_character = character;
-		}
+		for (const GlyphPosition& glyph_position : glyph_positions)
+			layer->GenerateGeometry(&geometry[geometry_index], glyph_position.character, Vector2f(position.x + scale * float(glyph_position.x), position.y), layer_colour, scale);
 
 		geometry_index += num_textures;
 	}
@@ -284,6 +383,9 @@ int FontFaceHandleDefault::GenerateString(GeometryList& geometry, const String&
 	// Cull any excess geometry from a previous generation.
 	geometry.resize(geometry_index);
 
+	if (scale != 1.f)
+		return Math::RoundToInteger(scale * float(line_width));
+
 	return line_width;
 }
 
@@ -291,20 +393,26 @@ bool FontFaceHandleDefault::UpdateLayersOnDirty()
 {
 	bool result = false;
 
-	// If we are dirty, regenerate all the layers and increment the version
+	// If we are dirty, add the new glyphs to all the layers. Existing glyphs keep their place in the layer textures,
+	// thus the version is only incremented if any textures in use had to be replaced.
 	if(is_layers_dirty && base_layer)
 	{
 		is_layers_dirty = false;
-		++version;
 
-		// Regenerate all the layers.
-		// Note: The layer regeneration needs to happen in the order in which the layers were created,
-		// otherwise we may end up cloning a layer which has not yet been regenerated. This means trouble!
+		bool replaced_textures = false;
+
+		// Update all the layers.
+		// Note: The layer update needs to happen in the order in which the layers were created,
+		// otherwise we may end up cloning a layer which has not yet been updated. This means trouble!
 		for (auto& pair : layers)
 		{
 			GenerateLayer(pair.layer.get());
+			replaced_textures |= pair.layer->HasReplacedTextures();
 		}
 
+		if (replaced_textures)
+			++version;
+
 		result = true;
 	}
 
@@ -313,17 +421,51 @@ bool FontFaceHandleDefault::UpdateLayersOnDirty()
 
 int FontFaceHandleDefault::GetVersion() const 
 {
-	return version;
+	if (reference_handle)
+		return reference_handle->GetVersion();
+
+	// Characters replaced before fallback faces were added may now have a glyph, thus text measured or generated
+	// before must be done again. Both counts only increase, so their sum changes whenever either of them does.
+	return version + FontProvider::CountFallbackFontFaces();
 }
 
-bool FontFaceHandleDefault::AppendGlyph(Character character)
+FontGlyphCache* FontFaceHandleDefault::GetGlyphCache() const
 {
-	bool result = FreeType::AppendGlyph(ft_face, metrics.size, character, glyphs);
-	return result;
+	return glyph_cache.get();
+}
+
+void FontFaceHandleDefault::SaveGlyphCache()
+{
+	// Glyphs taken from fallback faces belong to those faces, they are left out of our cache.
+	if (glyph_cache)
+		glyph_cache->Save(glyphs, metrics, missing_characters);
+}
+
+FontFaceHandleDefault::AppendGlyphResult FontFaceHandleDefault::AppendGlyph(Character character)
+{
+	FontFaceHandleFreetype ft_face = font_face->UseFreeTypeFace();
+	if (!ft_face)
+		return AppendGlyphResult::FaceUnavailable;
+
+	if (!FreeType::AppendGlyph(ft_face, metrics.size, character, glyphs))
+		return AppendGlyphResult::Missing;
+
+	if (glyph_cache)
+		glyph_cache->SetDirty();
+
+	return AppendGlyphResult::Appended;
 }
 
 int FontFaceHandleDefault::GetKerning(Character lhs, Character rhs) const
 {
+	// Faces without kerning are not loaded just to look it up.
+	if (!has_kerning)
+		return 0;
+
+	FontFaceHandleFreetype ft_face = font_face->UseFreeTypeFace();
+	if (!ft_face)
+		return 0;
+
 	int result = FreeType::GetKerning(ft_face, metrics.size, lhs, rhs);
 	return result;
 }
@@ -337,9 +479,22 @@ const FontGlyph* FontFaceHandleDefault::GetOrAppendGlyph(Character& character, b
 	auto it_glyph = glyphs.find(character);
 	if (it_glyph == glyphs.end())
 	{
-		bool result = AppendGlyph(character);
+		// Characters known to be missing from this face are not looked up in the font again.
+		AppendGlyphResult result = AppendGlyphResult::Missing;
+		if (missing_characters.find(character) == missing_characters.end())
+		{
+			result = AppendGlyph(character);
+			if (result == AppendGlyphResult::Missing)
+				missing_characters.insert(character);
+		}
 
-		if (result)
+		if (result == AppendGlyphResult::FaceUnavailable)
+		{
+			// The face could not be loaded right now, thus we can't tell whether the character is in the font. Nothing is
+			// recorded and no fallback glyph is taken, so that the character is looked up again the next time.
+			return nullptr;
+		}
+		else if (result == AppendGlyphResult::Appended)
 		{
 			it_glyph = glyphs.find(character);
 			if (it_glyph == glyphs.end())
@@ -353,27 +508,40 @@ const FontGlyph* FontFaceHandleDefault::GetOrAppendGlyph(Character& character, b
 		else if (look_in_fallback_fonts)
 		{
 			const int num_fallback_faces = FontProvider::CountFallbackFontFaces();
-			for (int i = 0; i < num_fallback_faces; i++)
+
+			// Characters found in none of the fallback fonts are only searched for again if fallback fonts have been added since.
+			if (num_fallback_faces != num_searched_fallback_faces)
 			{
-				FontFaceHandleDefault* fallback_face = FontProvider::GetFallbackFontFace(i, metrics.size);
-				if (!fallback_face || fallback_face == this)
-					continue;
+				replaced_characters.clear();
+				num_searched_fallback_faces = num_fallback_faces;
+			}
 
-				const FontGlyph* glyph = fallback_face->GetOrAppendGlyph(character, false);
-				if (glyph)
+			if (replaced_characters.find(character) == replaced_characters.end())
+			{
+				for (int i = 0; i < num_fallback_faces; i++)
 				{
-					// Insert the new glyph into our own set of glyphs
-					auto pair = glyphs.emplace(character, glyph->WeakCopy());
-					it_glyph = pair.first;
-					if(pair.second)
-						is_layers_dirty = true;
-					break;
+					FontFaceHandleDefault* fallback_face = FontProvider::GetFallbackFontFace(i, metrics.size);
+					if (!fallback_face || fallback_face == this)
+						continue;
+
+					const FontGlyph* glyph = fallback_face->GetOrAppendGlyph(character, false);
+					if (glyph)
+					{
+						// Insert the new glyph into our own set of glyphs
+						auto pair = glyphs.emplace(character, glyph->WeakCopy());
+						it_glyph = pair.first;
+						if(pair.second)
+							is_layers_dirty = true;
+						break;
+					}
 				}
 			}
 
 			// If we still have not found a glyph, use the replacement character.
 			if(it_glyph == glyphs.end())
 			{
+				replaced_characters.insert(character);
+
 				character = Character::Replacement;
 				it_glyph = glyphs.find(character);
 				if (it_glyph == glyphs.end())
@@ -39,7 +39,9 @@
 namespace Rml {
 namespace Core {
 
+class FontFace;
 class FontFaceLayer;
+class FontGlyphCache;
 
 
 /**
@@ -52,7 +54,15 @@ public:
 	FontFaceHandleDefault();
 	~FontFaceHandleDefault();
 
-	bool Initialize(FontFaceHandleFreetype face, int font_size);
+	/// Initializes the handle to render text using the given font face.
+	/// @param[in] face The font face, its FreeType face is loaded from it whenever glyphs are needed.
+	/// @param[in] font_size The size of this handle.
+	/// @param[in] font_hash The hash of the font data used to identify the face in the glyph cache, or zero to not use the cache.
+	bool Initialize(FontFace* face, int font_size, uint64_t font_hash = 0);
+	/// Initializes the handle to render text by scaling the glyphs and layers of a handle at another size.
+	/// @param[in] reference_handle The handle to scale. It must outlive this handle, and can't be scaled itself.
+	/// @param[in] font_size The size of this handle.
+	bool Initialize(FontFaceHandleDefault* reference_handle, int font_size);
 
 	/// Returns the point size of this font face.
 	int GetSize() const;
@@ -75,6 +85,12 @@ public:
 	/// @param[in] prior_character The optionally-specified character that immediately precedes the string. This may have an impact on the string width due to kerning.
 	/// @return The width, in pixels, this string will occupy if rendered with this handle.
 	int GetStringWidth(const String& string, Character prior_character = Character::Null);
+	/// Returns the advance of each character of a string of code points, as used by GetStringWidth().
+	/// @param[in] string The code points of the string to measure.
+	/// @param[in] num_characters The number of code points in the string.
+	/// @param[out] advances The advance of each character, including the kerning between it and the preceding character.
+	/// @param[in] prior_character The optionally-specified character that immediately precedes the string.
+	void GetCharacterAdvances(const Character* string, int num_characters, int* advances, Character prior_character = Character::Null);
 
 	/// Generates, if required, the layer configuration for a given list of font effects.
 	/// @param[in] font_effects The list of font effects to generate the configuration for.
@@ -85,24 +101,42 @@ public:
 	/// @param[out] texture_dimensions The dimensions of the texture.
 	/// @param[in] font_effect The font effect used for the layer.
 	/// @param[in] texture_id The index of the texture within the layer to generate.
-	/// @param[in] handle_version The version of the handle data. Function returns false if out of date.
-	bool GenerateLayerTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, const FontEffect* font_effect, int texture_id, int handle_version) const;
+	bool GenerateLayerTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, const FontEffect* font_effect, int texture_id) const;
 
 	/// Generates the geometry required to render a single line of text.
 	/// @param[out] geometry An array of geometries to generate the geometry into.
 	/// @param[in] string The string to render.
 	/// @param[in] position The position of the baseline of the first character to render.
 	/// @param[in] colour The colour to render the text.
+	/// @param[in] scale The scale applied to the glyphs of this handle, used when rendering the string for a scaled handle.
 	/// @return The width, in pixels, of the string geometry.
-	int GenerateString(GeometryList& geometry, const String& string, const Vector2f& position, const Colourb& colour, int layer_configuration = 0);
+	int GenerateString(GeometryList& geometry, const String& string, const Vector2f& position, const Colourb& colour, int layer_configuration = 0, float scale = 1.f);
+	/// Generates the geometry required to render a single line of text given as code points.
+	/// @param[out] geometry An array of geometries to generate the geometry into.
+	/// @param[in] string The code points of the string to render.
+	/// @param[in] num_characters The number of code points in the string.
+	/// @param[in] position The position of the baseline of the first character to render.
+	/// @param[in] colour The colour to render the text.
+	/// @param[in] scale The scale applied to the glyphs of this handle, used when rendering the string for a scaled handle.
+	/// @return The width, in pixels, of the string geometry.
+	int GenerateString(GeometryList& geometry, const Character* string, int num_characters, const Vector2f& position, const Colourb& colour, int layer_configuration = 0, float scale = 1.f);
+
+	/// Returns the persistent glyph cache of this handle, or nullptr if the cache is not used.
+	FontGlyphCache* GetGlyphCache() const;
+	/// Writes the glyph cache of this handle, if any new glyphs have been generated since it was last written.
+	void SaveGlyphCache();
 
-	/// Version is changed whenever the layers are dirtied, requiring regeneration of string geometry.
+	/// Version is changed whenever previously generated string geometry or measured text becomes invalid, such as when
+	/// layer textures in use are replaced or fallback faces are added.
 	int GetVersion() const;
 
 
 private:
-	// Build and append glyph to 'glyphs'
-	bool AppendGlyph(Character character);
+	enum class AppendGlyphResult { Appended, Missing, FaceUnavailable };
+
+	// Build and append glyph to 'glyphs'. Missing is returned if the font has no glyph for the character, and
+	// FaceUnavailable if the FreeType face could not be loaded right now, in which case the glyph may be found later.
+	AppendGlyphResult AppendGlyph(Character character);
 
 	int GetKerning(Character lhs, Character rhs) const;
 
@@ -112,7 +146,7 @@ private:
 	/// @return The font glyph for the returned code point.
 	const FontGlyph* GetOrAppendGlyph(Character& character, bool look_in_fallback_fonts = true);
 
-	// Regenerate layers if dirty, such as after adding new glyphs.
+	// Add new glyphs to the layers if dirty.
 	bool UpdateLayersOnDirty();
 
 	// Create a new layer from the given font effect if it does not already exist.
@@ -123,6 +157,13 @@ private:
 
 	FontGlyphMap glyphs;
 
+	// Characters without a glyph in the font of this face.
+	UnorderedSet<Character> missing_characters;
+	// Characters without a glyph in this face or any of the fallback faces, rendered as the replacement character.
+	UnorderedSet<Character> replaced_characters;
+	// The number of fallback faces available when the replaced characters were searched for.
+	int num_searched_fallback_faces = 0;
+
 	struct EffectLayerPair {
 		const FontEffect* font_effect;
 		UniquePtr<FontFaceLayer> layer; 
@@ -146,7 +187,25 @@ private:
 
 	FontMetrics metrics;
 
-	FontFaceHandleFreetype ft_face;
+	// The face which owns this handle, or nullptr if the handle is scaled from a reference handle.
+	FontFace* font_face;
+	// Whether the face has kerning, cached when the handle is created so that looking up kerning doesn't load the face.
+	bool has_kerning = false;
+
+	UniquePtr<FontGlyphCache> glyph_cache;
+
+	// The handle whose glyphs and layers are scaled to render the text of this handle, or nullptr if it has its own.
+	FontFaceHandleDefault* reference_handle = nullptr;
+	float reference_scale = 1.f;
+
+	struct GlyphPosition {
+		Character character;
+		int x;
+	};
+
+	// Scratch buffers reused between string generations.
+	std::vector<Character> string_characters;
+	std::vector<GlyphPosition> glyph_positions;
 };
 
 }
@@ -28,6 +28,9 @@
 
 #include "FontFaceLayer.h"
 #include "FontFaceHandleDefault.h"
+#include "FontGlyphCache.h"
+#include <algorithm>
+#include <string.h>
 
 namespace Rml {
 namespace Core {
@@ -44,45 +47,34 @@ FontFaceLayer::~FontFaceLayer()
 
 bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFaceLayer* clone, bool clone_glyph_origins)
 {
-	// Clear the old layout if it exists.
-	{
-		// @performance: We could be much smarter about this, e.g. such as adding new glyphs to the existing texture layout and textures.
-		// Right now we re-generate the whole thing, including textures.
-		texture_layout = TextureLayout{};
-		character_boxes.clear();
-		textures.clear();
-	}
+	replaced_textures = false;
 
 	const FontGlyphMap& glyphs = handle->GetGlyphs();
 
-	// Generate the new layout.
 	if (clone)
 	{
-		// Clone the geometry and textures from the clone layer.
-		character_boxes = clone->character_boxes;
+		// Clone the geometry of any new glyphs from the clone layer.
+		for (auto& pair : glyphs)
+		{
+			Character character = pair.first;
+			const FontGlyph& glyph = pair.second;
 
-		// Copy the cloned layer's textures.
-		for (size_t i = 0; i < clone->textures.size(); ++i)
-			textures.push_back(clone->textures[i]);
+			if (character_boxes.find(character) != character_boxes.end())
+				continue;
 
-		// Request the effect (if we have one) and adjust the origins as appropriate.
-		if (effect && !clone_glyph_origins)
-		{
-			for (auto& pair : glyphs)
+			auto it = clone->character_boxes.find(character);
+			if (it == clone->character_boxes.end())
 			{
-				Character character = pair.first;
-				const FontGlyph& glyph = pair.second;
-
-				auto it = character_boxes.find(character);
-				if (it == character_boxes.end())
-				{
-					// This can happen if the layers have been dirtied in FontHandleDefault. We will
-					// probably be regenerated soon, just skip the character for now.
-					continue;
-				}
+				// This can happen if the layers have been dirtied in FontHandleDefault. We will
+				// probably be regenerated soon, just skip the character for now.
+				continue;
+			}
 
-				TextureBox& box = it->second;
+			TextureBox box = it->second;
 
+			// Request the effect (if we have one) and adjust the origins as appropriate.
+			if (effect && !clone_glyph_origins)
+			{
 				Vector2i glyph_origin(Math::RealToInteger(box.origin.x), Math::RealToInteger(box.origin.y));
 				Vector2i glyph_dimensions(Math::RealToInteger(box.dimensions.x), Math::RealToInteger(box.dimensions.y));
 
@@ -94,142 +86,315 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 				else
 					box.texture_index = -1;
 			}
+
+			character_boxes[character] = box;
 		}
+
+		// Share the cloned layer's textures. Our existing textures are assigned in place, as geometry may refer to them.
+		for (size_t i = 0; i < clone->textures.size(); ++i)
+		{
+			if (i < textures.size())
+				textures[i] = clone->textures[i];
+			else
+				textures.push_back(clone->textures[i]);
+		}
+
+		return true;
 	}
-	else
+
+	// Effect glyphs are taken from the persistent glyph cache when available, instead of being generated again.
+	FontGlyphCache* glyph_cache = (effect && effect->GetFingerprint() != 0 ? handle->GetGlyphCache() : nullptr);
+	const size_t fingerprint = (effect ? effect->GetFingerprint() : 0);
+
+	// Find the glyphs not yet in the layer and determine their geometry.
+	std::vector<Character> new_characters;
+	int square_pixels = 0;
+
+	for (auto& pair : glyphs)
 	{
-		// Initialise the texture layout for the glyphs.
-		character_boxes.reserve(glyphs.size());
-		for (auto& pair : glyphs)
-		{
-			Character character = pair.first;
-			const FontGlyph& glyph = pair.second;
+		Character character = pair.first;
+		const FontGlyph& glyph = pair.second;
+
+		if (character_boxes.find(character) != character_boxes.end())
+			continue;
 
-			Vector2i glyph_origin(0, 0);
-			Vector2i glyph_dimensions = glyph.bitmap_dimensions;
+		// Glyphs without geometry in this layer are still added, so that they are not considered again.
+		TextureBox& box = character_boxes[character];
 
-			// Adjust glyph origin / dimensions for the font effect.
-			if (effect)
+		Vector2i glyph_origin(0, 0);
+		Vector2i glyph_dimensions = glyph.bitmap_dimensions;
+
+		// Adjust glyph origin / dimensions for the font effect.
+		if (effect)
+		{
+			FontGlyphCache::LayerGlyph cached_glyph;
+			if (glyph_cache && glyph_cache->GetLayerGlyph(fingerprint, character, cached_glyph))
 			{
-				if (!effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
+				if (!cached_glyph.has_geometry)
 					continue;
+
+				glyph_origin = cached_glyph.origin;
+				glyph_dimensions = cached_glyph.dimensions;
 			}
+			else if (!effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
+			{
+				if (glyph_cache)
+					glyph_cache->AddLayerGlyph(fingerprint, character, false, Vector2i(0, 0), Vector2i(0, 0), nullptr, 0);
+				continue;
+			}
+		}
 
-			TextureBox box;
-			box.origin = Vector2f(float(glyph_origin.x + glyph.bearing.x), float(glyph_origin.y - glyph.bearing.y));
-			box.dimensions = Vector2f(float(glyph_dimensions.x), float(glyph_dimensions.y));
-			
-			RMLUI_ASSERT(box.dimensions.x >= 0 && box.dimensions.y >= 0);
+		box.origin = Vector2f(float(glyph_origin.x + glyph.bearing.x), float(glyph_origin.y - glyph.bearing.y));
+		box.dimensions = Vector2f(float(glyph_dimensions.x), float(glyph_dimensions.y));
 
-			character_boxes[character] = box;
+		RMLUI_ASSERT(box.dimensions.x >= 0 && box.dimensions.y >= 0);
 
-			// Add the character's dimensions into the texture layout engine.
-			texture_layout.AddRectangle((int)character, glyph_dimensions);
+		if (glyph_dimensions.x > 0 && glyph_dimensions.y > 0)
+		{
+			new_characters.push_back(character);
+			square_pixels += (glyph_dimensions.x + 1) * (glyph_dimensions.y + 1);
 		}
+	}
+
+	if (new_characters.empty())
+		return true;
 
+	// Size the atlas pages on the first generation. Leave room for about as many glyphs as there are initially, so
+	// that glyphs added later usually fit in the first texture.
+	if (atlas.GetNumPages() == 0)
+	{
+		constexpr int min_texture_dimensions = 128;
 		constexpr int max_texture_dimensions = 1024;
 
-		// Generate the texture layout; this will position the glyph rectangles efficiently and
-		// allocate the texture data ready for writing.
-		if (!texture_layout.GenerateLayout(max_texture_dimensions))
-			return false;
+		int texture_width = Math::ToPowerOfTwo(Math::RealToInteger(Math::SquareRoot(float(2 * square_pixels))));
+		texture_width = Math::Clamp(texture_width, min_texture_dimensions, max_texture_dimensions);
 
+		atlas.SetPageDimensions(Vector2i(texture_width));
+	}
 
-		// Iterate over each rectangle in the layout, copying the glyph data into the rectangle as
-		// appropriate and generating geometry.
-		for (int i = 0; i < texture_layout.GetNumRectangles(); ++i)
+	// Place the tallest glyphs first, this packs the glyphs more tightly onto the atlas shelves. Ties are ordered by
+	// character so that the layout does not depend on the order of the glyph map, such as when loaded from the cache.
+	std::sort(new_characters.begin(), new_characters.end(), [this](Character a, Character b) {
+		const float height_a = character_boxes[a].dimensions.y;
+		const float height_b = character_boxes[b].dimensions.y;
+		return height_a > height_b || (height_a == height_b && a < b);
+	});
+
+	std::vector<Vector2i> new_dimensions;
+	new_dimensions.reserve(new_characters.size());
+	for (Character character : new_characters)
+	{
+		const TextureBox& box = character_boxes[character];
+		new_dimensions.emplace_back(Math::RealToInteger(box.dimensions.x), Math::RealToInteger(box.dimensions.y));
+	}
+
+	// Place all the new glyphs at once, so that they are either all added or none of them are. Their boxes are removed
+	// on failure so that they are tried again on the next generation.
+	std::vector<int> texture_indices;
+	std::vector<Vector2i> positions;
+	if (!atlas.Allocate(new_dimensions, texture_indices, positions))
+	{
+		for (Character character : new_characters)
+			character_boxes.erase(character);
+		return false;
+	}
+
+	std::vector<byte> glyph_data;
+
+	for (size_t i = 0; i < new_characters.size(); ++i)
+	{
+		const Character character = new_characters[i];
+		TextureBox& box = character_boxes[character];
+		const Vector2i glyph_dimensions = new_dimensions[i];
+		const Vector2i texture_dimensions = atlas.GetPageDimensions(texture_indices[i]);
+
+		// Set the character's texture index and texture coordinates.
+		box.texture_index = texture_indices[i];
+		box.texture_position = positions[i];
+		box.texcoords[0].x = float(positions[i].x) / float(texture_dimensions.x);
+		box.texcoords[0].y = float(positions[i].y) / float(texture_dimensions.y);
+		box.texcoords[1].x = float(positions[i].x + glyph_dimensions.x) / float(texture_dimensions.x);
+		box.texcoords[1].y = float(positions[i].y + glyph_dimensions.y) / float(texture_dimensions.y);
+
+		// Store the images of new effect glyphs in the glyph cache. The textures then copy them from the cache instead
+		// of generating them again.
+		FontGlyphCache::LayerGlyph cached_glyph;
+		if (glyph_cache && !glyph_cache->GetLayerGlyph(fingerprint, character, cached_glyph))
 		{
-			TextureLayoutRectangle& rectangle = texture_layout.GetRectangle(i);
-			const TextureLayoutTexture& texture = texture_layout.GetTexture(rectangle.GetTextureIndex());
-			Character character = (Character)rectangle.GetId();
-			RMLUI_ASSERT(character_boxes.find(character) != character_boxes.end());
-			TextureBox& box = character_boxes[character];
-
-			// Set the character's texture index.
-			box.texture_index = rectangle.GetTextureIndex();
-
-			// Generate the character's texture coordinates.
-			box.texcoords[0].x = float(rectangle.GetPosition().x) / float(texture.GetDimensions().x);
-			box.texcoords[0].y = float(rectangle.GetPosition().y) / float(texture.GetDimensions().y);
-			box.texcoords[1].x = float(rectangle.GetPosition().x + rectangle.GetDimensions().x) / float(texture.GetDimensions().x);
-			box.texcoords[1].y = float(rectangle.GetPosition().y + rectangle.GetDimensions().y) / float(texture.GetDimensions().y);
+			const FontGlyph& glyph = glyphs.find(character)->second;
+			const int stride = glyph_dimensions.x * 4;
+
+			glyph_data.resize(size_t(stride * glyph_dimensions.y));
+			ClearTextureData(glyph_data.data(), glyph_dimensions.x * glyph_dimensions.y);
+			effect->GenerateGlyphTexture(glyph_data.data(), glyph_dimensions, stride, glyph);
+
+			const Vector2i glyph_origin(Math::RealToInteger(box.origin.x) - glyph.bearing.x, Math::RealToInteger(box.origin.y) + glyph.bearing.y);
+			glyph_cache->AddLayerGlyph(fingerprint, character, true, glyph_origin, glyph_dimensions, glyph_data.data(), stride);
 		}
+	}
 
-		const FontEffect* effect_ptr = effect.get();
-		const int handle_version = handle->GetVersion();
+	// Add textures for any new pages of the atlas, and upload the regions of the existing textures where glyphs were
+	// added. Textures not yet generated by the render interface pick up the new glyphs when they are.
+	for (int i = 0; i < atlas.GetNumPages(); ++i)
+	{
+		Vector2i region_offset, region_dimensions;
+		const bool dirty = atlas.GetDirtyRegion(i, region_offset, region_dimensions);
+		atlas.ClearDirtyRegion(i);
 
-		// Generate the textures.
-		for (int i = 0; i < texture_layout.GetNumTextures(); ++i)
+		if (i >= (int)textures.size())
 		{
-			int texture_id = i;
-
-			TextureCallback texture_callback = [handle, effect_ptr, texture_id, handle_version](const String& name, UniquePtr<const byte[]>& data, Vector2i& dimensions) -> bool {
-				bool result = handle->GenerateLayerTexture(data, dimensions, effect_ptr, texture_id, handle_version);
-				return result;
-			};
+			textures.emplace_back();
+			SetTexture(textures.back(), handle, i);
+		}
+		else if (dirty)
+		{
+			UniquePtr<const byte[]> region_data = GenerateTextureRegion(handle, i, region_offset, region_dimensions);
 
-			Texture texture;
-			texture.Set("font-face-layer", texture_callback);
-			textures.push_back(texture);
+			// If the render interface can't update the texture, it is released and generated again with a new handle.
+			if (!textures[i].Update(region_offset, region_dimensions, region_data.get(), region_dimensions.x * 4))
+				replaced_textures = true;
 		}
 	}
 
 	return true;
 }
 
+bool FontFaceLayer::HasReplacedTextures() const
+{
+	return replaced_textures;
+}
+
 // Generates the texture data for a layer (for the texture database).
-bool FontFaceLayer::GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphMap& glyphs)
+bool FontFaceLayer::GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontFaceHandleDefault* handle) const
 {
 	if (texture_id < 0 ||
-		texture_id > texture_layout.GetNumTextures())
+		texture_id >= atlas.GetNumPages())
 		return false;
 
-	// Generate the texture data.
-	texture_data = texture_layout.GetTexture(texture_id).AllocateTexture();
-	texture_dimensions = texture_layout.GetTexture(texture_id).GetDimensions();
+	texture_dimensions = atlas.GetPageDimensions(texture_id);
+	texture_data = GenerateTextureRegion(handle, texture_id, Vector2i(0, 0), texture_dimensions);
 
-	for (int i = 0; i < texture_layout.GetNumRectangles(); ++i)
-	{
-		TextureLayoutRectangle& rectangle = texture_layout.GetRectangle(i);
-		Character character = (Character)rectangle.GetId();
-		RMLUI_ASSERT(character_boxes.find(character) != character_boxes.end());
+	return true;
+}
 
-		TextureBox& box = character_boxes[character];
+UniquePtr<const byte[]> FontFaceLayer::GenerateTextureRegion(const FontFaceHandleDefault* handle, int texture_id, Vector2i region_offset, Vector2i region_dimensions) const
+{
+	const int stride = region_dimensions.x * 4;
+	UniquePtr<byte[]> data(new byte[size_t(stride * region_dimensions.y)]);
+	ClearTextureData(data.get(), region_dimensions.x * region_dimensions.y);
+
+	const FontGlyphMap& glyphs = handle->GetGlyphs();
+	const FontGlyphCache* glyph_cache = (effect && effect->GetFingerprint() != 0 ? handle->GetGlyphCache() : nullptr);
+	const Vector2i region_end = region_offset + region_dimensions;
+
+	std::vector<byte> glyph_data;
+
+	for (auto& pair : character_boxes)
+	{
+		const Character character = pair.first;
+		const TextureBox& box = pair.second;
 
 		if (box.texture_index != texture_id)
 			continue;
 
-		auto it = glyphs.find((Character)rectangle.GetId());
+		auto it = glyphs.find(character);
 		if (it == glyphs.end())
 			continue;
 
-		const FontGlyph& glyph = it->second;
+		const Vector2i glyph_dimensions(Math::RealToInteger(box.dimensions.x), Math::RealToInteger(box.dimensions.y));
+		const Vector2i glyph_end = box.texture_position + glyph_dimensions;
+
+		const Vector2i clip_min(Math::Max(box.texture_position.x, region_offset.x), Math::Max(box.texture_position.y, region_offset.y));
+		const Vector2i clip_max(Math::Min(glyph_end.x, region_end.x), Math::Min(glyph_end.y, region_end.y));
+
+		if (clip_min.x >= clip_max.x || clip_min.y >= clip_max.y)
+			continue;
 
-		if (effect == nullptr)
+		if (clip_min == box.texture_position && clip_max == glyph_end)
+		{
+			byte* destination = data.get() + (box.texture_position.y - region_offset.y) * stride + (box.texture_position.x - region_offset.x) * 4;
+			GenerateGlyph(destination, stride, character, glyph_dimensions, it->second, glyph_cache);
+		}
+		else
 		{
-			// Copy the glyph's bitmap data into its allocated texture.
-			if (glyph.bitmap_data)
+			// The glyph is only partly inside the region, generate it on its own and copy the part inside the region.
+			const int glyph_stride = glyph_dimensions.x * 4;
+			glyph_data.resize(size_t(glyph_stride * glyph_dimensions.y));
+			ClearTextureData(glyph_data.data(), glyph_dimensions.x * glyph_dimensions.y);
+			GenerateGlyph(glyph_data.data(), glyph_stride, character, glyph_dimensions, it->second, glyph_cache);
+
+			for (int y = clip_min.y; y < clip_max.y; ++y)
 			{
-				byte* destination = rectangle.GetTextureData();
-				const byte* source = glyph.bitmap_data;
+				byte* destination = data.get() + (y - region_offset.y) * stride + (clip_min.x - region_offset.x) * 4;
+				const byte* source = glyph_data.data() + (y - box.texture_position.y) * glyph_stride + (clip_min.x - box.texture_position.x) * 4;
+				memcpy(destination, source, size_t((clip_max.x - clip_min.x) * 4));
+			}
+		}
+	}
 
-				for (int j = 0; j < glyph.bitmap_dimensions.y; ++j)
-				{
-					for (int k = 0; k < glyph.bitmap_dimensions.x; ++k)
-						destination[k * 4 + 3] = source[k];
+	return UniquePtr<const byte[]>(std::move(data));
+}
 
-					destination += rectangle.GetTextureStride();
-					source += glyph.bitmap_dimensions.x;
-				}
+void FontFaceLayer::GenerateGlyph(byte* destination, int stride, Character character, Vector2i glyph_dimensions, const FontGlyph& glyph, const FontGlyphCache* glyph_cache) const
+{
+	if (effect == nullptr)
+	{
+		// Copy the glyph's bitmap data into its place in the texture.
+		if (glyph.bitmap_data)
+		{
+			const byte* source = glyph.bitmap_data;
+
+			for (int j = 0; j < glyph.bitmap_dimensions.y; ++j)
+			{
+				for (int k = 0; k < glyph.bitmap_dimensions.x; ++k)
+					destination[k * 4 + 3] = source[k];
+
+				destination += stride;
+				source += glyph.bitmap_dimensions.x;
 			}
 		}
-		else
+
+		return;
+	}
+
+	FontGlyphCache::LayerGlyph cached_glyph;
+	if (glyph_cache && glyph_cache->GetLayerGlyph(effect->GetFingerprint(), character, cached_glyph) && cached_glyph.data &&
+		cached_glyph.dimensions == glyph_dimensions)
+	{
+		// Copy the cached glyph image into its place in the texture.
+		const int row_size = glyph_dimensions.x * 4;
+		const byte* source = cached_glyph.data;
+
+		for (int j = 0; j < glyph_dimensions.y; ++j)
 		{
-			effect->GenerateGlyphTexture(rectangle.GetTextureData(), Vector2i(Math::RealToInteger(box.dimensions.x), Math::RealToInteger(box.dimensions.y)), rectangle.GetTextureStride(), glyph);
+			memcpy(destination, source, row_size);
+			destination += stride;
+			source += row_size;
 		}
 	}
+	else
+	{
+		effect->GenerateGlyphTexture(destination, glyph_dimensions, stride, glyph);
+	}
+}
 
-	return true;
+void FontFaceLayer::ClearTextureData(byte* data, int num_pixels)
+{
+	// Set the pixels to transparent white.
+	for (int i = 0; i < num_pixels; i++)
+		((unsigned int*)data)[i] = 0x00ffffff;
+}
+
+void FontFaceLayer::SetTexture(Texture& texture, const FontFaceHandleDefault* handle, int texture_id)
+{
+	const FontEffect* effect_ptr = effect.get();
+
+	TextureCallback texture_callback = [handle, effect_ptr, texture_id](const String& name, UniquePtr<const byte[]>& data, Vector2i& dimensions) -> bool {
+		bool result = handle->GenerateLayerTexture(data, dimensions, effect_ptr, texture_id);
+		return result;
+	};
+
+	texture.Set("font-face-layer", texture_callback);
 }
 
 // Returns the effect used to generate the layer.
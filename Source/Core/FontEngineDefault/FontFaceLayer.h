@@ -33,13 +33,15 @@
 #include "../../../Include/RmlUi/Core/Geometry.h"
 #include "../../../Include/RmlUi/Core/GeometryUtilities.h"
 #include "../../../Include/RmlUi/Core/Texture.h"
-#include "../TextureLayout.h"
+#include "FontGlyphAtlas.h"
+#include <deque>
 
 namespace Rml {
 namespace Core {
 
 class FontEffect;
 class FontFaceHandleDefault;
+class FontGlyphCache;
 
 /**
 	A textured layer stored as part of a font face handle. Each handle will have at least a base
@@ -54,26 +56,32 @@ public:
 	FontFaceLayer(const SharedPtr<const FontEffect>& _effect);
 	~FontFaceLayer();
 
-	/// Generates or re-generates the character and texture data for the layer.
+	/// Generates the character and texture data for any glyphs of the handle not yet in the layer. New glyphs are
+	/// placed in the free space of the layer's textures, existing glyphs keep their place and texture coordinates.
 	/// @param[in] handle The handle generating this layer.
-	/// @param[in] effect The effect to initialise the layer with.
 	/// @param[in] clone The layer to optionally clone geometry and texture data from.
+	/// @param[in] clone_glyph_origins True to keep the glyph origins of the cloned layer, false to adjust them for this layer's effect.
 	/// @return True if the layer was generated successfully, false if not.
 	bool Generate(const FontFaceHandleDefault* handle, const FontFaceLayer* clone = nullptr, bool clone_glyph_origins = false);
 
+	/// Returns true if the last generation had to release textures already generated by a render interface, as it
+	/// could not update them. Their handles change, making geometry compiled with them out of date.
+	bool HasReplacedTextures() const;
+
 	/// Generates the texture data for a layer (for the texture database).
 	/// @param[out] texture_data The pointer to be set to the generated texture data.
 	/// @param[out] texture_dimensions The dimensions of the texture.
 	/// @param[in] texture_id The index of the texture within the layer to generate.
-	/// @param[in] glyphs The glyphs required by the font face handle.
-	bool GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphMap& glyphs);
+	/// @param[in] handle The handle owning this layer.
+	bool GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontFaceHandleDefault* handle) const;
 
 	/// Generates the geometry required to render a single character.
 	/// @param[out] geometry An array of geometries this layer will write to. It must be at least as big as the number of textures in this layer.
 	/// @param[in] character_code The character to generate geometry for.
 	/// @param[in] position The position of the baseline.
 	/// @param[in] colour The colour of the string.
-	inline void GenerateGeometry(Geometry* geometry, const Character character_code, const Vector2f& position, const Colourb& colour) const
+	/// @param[in] scale The scale to apply to the character's geometry.
+	inline void GenerateGeometry(Geometry* geometry, const Character character_code, const Vector2f& position, const Colourb& colour, float scale = 1.f) const
 	{
 		auto it = character_boxes.find(character_code);
 		if (it == character_boxes.end())
@@ -93,8 +101,8 @@ public:
 		GeometryUtilities::GenerateQuad(
 			&character_vertices[0] + (character_vertices.size() - 4),
 			&character_indices[0] + (character_indices.size() - 6),
-			Vector2f(position.x + box.origin.x, position.y + box.origin.y).Round(),
-			box.dimensions,
+			Vector2f(position.x + scale * box.origin.x, position.y + scale * box.origin.y).Round(),
+			box.dimensions * scale,
 			colour,
 			box.texcoords[0],
 			box.texcoords[1],
@@ -126,17 +134,32 @@ private:
 		Vector2f dimensions;
 		// The texture coordinates for the character's geometry.
 		Vector2f texcoords[2];
+		// The position, in pixels, of the character's bitmap within its texture.
+		Vector2i texture_position;
 
-		// The texture this character renders from.
+		// The texture this character renders from, or -1 if the character has no geometry in this layer.
 		int texture_index;
 	};
 
 	using CharacterMap = UnorderedMap<Character, TextureBox>;
-	using TextureList = std::vector<Texture>;
+	// Geometry refers to the textures by address, thus they must stay in place as new textures are added.
+	using TextureList = std::deque<Texture>;
+
+	// Sets the texture to generate its data from the given page of the atlas.
+	void SetTexture(Texture& texture, const FontFaceHandleDefault* handle, int texture_id);
+
+	// Generates the RGBA data of a region of one of the layer's textures, with rows of tightly packed pixels.
+	UniquePtr<const byte[]> GenerateTextureRegion(const FontFaceHandleDefault* handle, int texture_id, Vector2i region_offset, Vector2i region_dimensions) const;
+	// Generates the image of a single glyph into the destination, which must be cleared beforehand.
+	void GenerateGlyph(byte* destination, int stride, Character character, Vector2i glyph_dimensions, const FontGlyph& glyph, const FontGlyphCache* glyph_cache) const;
+	// Sets the given number of pixels to transparent white.
+	static void ClearTextureData(byte* data, int num_pixels);
 
 	SharedPtr<const FontEffect> effect;
 
-	TextureLayout texture_layout;
+	// The layout of the glyphs in the layer's textures, unused if the textures are cloned from another layer.
+	FontGlyphAtlas atlas;
+	bool replaced_textures = false;
 
 	CharacterMap character_boxes;
 	TextureList textures;
@@ -62,9 +62,8 @@ FontFaceHandleDefault* FontFamily::GetFaceHandle(Style::FontStyle style, Style::
 
 
 // Adds a new face to the family.
-FontFace* FontFamily::AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle style, Style::FontWeight weight, bool release_stream)
+FontFace* FontFamily::AddFace(UniquePtr<FontFace> face)
 {
-	auto face = std::make_unique<FontFace>(ft_face, style, weight, release_stream);
 	FontFace* result = face.get();
 
 	font_faces.push_back(std::move(face));
@@ -72,5 +71,11 @@ FontFace* FontFamily::AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle s
 	return result;
 }
 
+void FontFamily::SaveGlyphCaches()
+{
+	for (auto& face : font_faces)
+		face->SaveGlyphCaches();
+}
+
 }
 }
@@ -55,12 +55,12 @@ public:
 
 
 	/// Adds a new face to the family.
-	/// @param[in] ft_face The previously loaded FreeType face.
-	/// @param[in] style The style of the new face.
-	/// @param[in] weight The weight of the new face.
-	/// @param[in] release_stream True if the application must free the face's memory stream.
-	/// @return True if the face was loaded successfully, false otherwise.
-	FontFace* AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle style, Style::FontWeight weight, bool release_stream);
+	/// @param[in] face The new face.
+	/// @return The added face.
+	FontFace* AddFace(UniquePtr<FontFace> face);
+
+	/// Writes the glyph caches of the family's faces which generated new glyphs.
+	void SaveGlyphCaches();
 
 protected:
 	String name;
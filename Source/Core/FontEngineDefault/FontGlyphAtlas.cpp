@@ -0,0 +1,186 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#include "FontGlyphAtlas.h"
+#include "../../../Include/RmlUi/Core/Math.h"
+
+namespace Rml {
+namespace Core {
+
+FontGlyphAtlas::FontGlyphAtlas() : page_dimensions(256, 256)
+{}
+
+FontGlyphAtlas::~FontGlyphAtlas()
+{}
+
+void FontGlyphAtlas::SetPageDimensions(Vector2i dimensions)
+{
+	page_dimensions = dimensions;
+}
+
+bool FontGlyphAtlas::Allocate(Vector2i dimensions, int& page_index, Vector2i& position)
+{
+	if (dimensions.x <= 0 || dimensions.y <= 0)
+		return false;
+
+	for (int i = 0; i < (int)pages.size(); i++)
+	{
+		if (Place(pages[i], dimensions, position))
+		{
+			page_index = i;
+			DirtyRegion(pages[i], position, dimensions);
+			return true;
+		}
+	}
+
+	// None of the existing pages have room, add a new one. Rectangles larger than the regular page size get a page
+	// of their own, large enough to hold them along with the spacing around them.
+	Page page;
+	page.dimensions.x = Math::Max(page_dimensions.x, Math::ToPowerOfTwo(dimensions.x + 2));
+	page.dimensions.y = Math::Max(page_dimensions.y, Math::ToPowerOfTwo(dimensions.y + 2));
+	page.shelf_y = 1;
+	page.dirty_min = page.dimensions;
+	page.dirty_max = Vector2i(0, 0);
+
+	pages.push_back(std::move(page));
+
+	page_index = (int)pages.size() - 1;
+	bool result = Place(pages.back(), dimensions, position);
+	RMLUI_ASSERT(result);
+
+	if (result)
+		DirtyRegion(pages.back(), position, dimensions);
+
+	return result;
+}
+
+bool FontGlyphAtlas::Allocate(const std::vector<Vector2i>& dimensions, std::vector<int>& page_indices, std::vector<Vector2i>& positions)
+{
+	// Keep the current layout so that it can be restored if any of the rectangles can't be allocated. The pages only
+	// hold their shelves, thus this copy is cheap.
+	const std::vector<Page> previous_pages = pages;
+
+	page_indices.resize(dimensions.size());
+	positions.resize(dimensions.size());
+
+	for (size_t i = 0; i < dimensions.size(); i++)
+	{
+		if (!Allocate(dimensions[i], page_indices[i], positions[i]))
+		{
+			pages = previous_pages;
+			page_indices.clear();
+			positions.clear();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int FontGlyphAtlas::GetNumPages() const
+{
+	return (int)pages.size();
+}
+
+Vector2i FontGlyphAtlas::GetPageDimensions(int page_index) const
+{
+	RMLUI_ASSERT(page_index >= 0 && page_index < (int)pages.size());
+	return pages[page_index].dimensions;
+}
+
+bool FontGlyphAtlas::GetDirtyRegion(int page_index, Vector2i& region_offset, Vector2i& region_dimensions) const
+{
+	RMLUI_ASSERT(page_index >= 0 && page_index < (int)pages.size());
+	const Page& page = pages[page_index];
+
+	if (page.dirty_min.x >= page.dirty_max.x || page.dirty_min.y >= page.dirty_max.y)
+		return false;
+
+	region_offset = page.dirty_min;
+	region_dimensions = page.dirty_max - page.dirty_min;
+
+	return true;
+}
+
+void FontGlyphAtlas::ClearDirtyRegion(int page_index)
+{
+	RMLUI_ASSERT(page_index >= 0 && page_index < (int)pages.size());
+	Page& page = pages[page_index];
+
+	page.dirty_min = page.dimensions;
+	page.dirty_max = Vector2i(0, 0);
+}
+
+bool FontGlyphAtlas::Place(Page& page, Vector2i dimensions, Vector2i& position)
+{
+	// An extra pixel is kept free to the right of and below each rectangle so that the rectangles aren't pushed up
+	// against each other. This will avoid filtering artifacts.
+	const bool fits_new_shelf = (page.shelf_y + dimensions.y + 1 <= page.dimensions.y);
+
+	// Find the tightest shelf with room for the rectangle, that is the one with the smallest height that fits it.
+	Shelf* best_shelf = nullptr;
+	for (Shelf& shelf : page.shelves)
+	{
+		if (shelf.height >= dimensions.y && shelf.x + dimensions.x + 1 <= page.dimensions.x)
+		{
+			if (!best_shelf || shelf.height < best_shelf->height)
+				best_shelf = &shelf;
+		}
+	}
+
+	// Prefer opening a new shelf over wasting more than half the height of an existing one.
+	if (best_shelf && fits_new_shelf && best_shelf->height - dimensions.y > dimensions.y / 2)
+		best_shelf = nullptr;
+
+	if (!best_shelf)
+	{
+		if (!fits_new_shelf || dimensions.x + 2 > page.dimensions.x)
+			return false;
+
+		page.shelves.push_back(Shelf{ page.shelf_y, dimensions.y, 1 });
+		page.shelf_y += dimensions.y + 1;
+		best_shelf = &page.shelves.back();
+	}
+
+	position = Vector2i(best_shelf->x, best_shelf->y);
+	best_shelf->x += dimensions.x + 1;
+
+	return true;
+}
+
+void FontGlyphAtlas::DirtyRegion(Page& page, Vector2i position, Vector2i dimensions)
+{
+	page.dirty_min.x = Math::Min(page.dirty_min.x, position.x);
+	page.dirty_min.y = Math::Min(page.dirty_min.y, position.y);
+	page.dirty_max.x = Math::Max(page.dirty_max.x, position.x + dimensions.x);
+	page.dirty_max.y = Math::Max(page.dirty_max.y, position.y + dimensions.y);
+}
+
+}
+}
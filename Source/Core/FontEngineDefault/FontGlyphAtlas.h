@@ -0,0 +1,110 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#ifndef RMLUICOREFONTGLYPHATLAS_H
+#define RMLUICOREFONTGLYPHATLAS_H
+
+#include "../../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+namespace Core {
+
+/**
+	A dynamic atlas for the glyph bitmaps of a font face layer.
+
+	Rectangles are packed onto shelves within fixed-size pages. New rectangles are placed in the remaining free space
+	of the existing shelves and pages, and a new page is only added when none of them have room. Rectangles are never
+	moved once allocated, thus their texture coordinates stay valid as glyphs are added. The atlas only keeps track of
+	the layout of the pages, their pixel data is generated by the owner when needed.
+ */
+
+class FontGlyphAtlas
+{
+public:
+	FontGlyphAtlas();
+	~FontGlyphAtlas();
+
+	/// Sets the dimensions of new pages. Pages already added keep their dimensions.
+	void SetPageDimensions(Vector2i dimensions);
+
+	/// Allocates a rectangle in the atlas, adding a new page if it does not fit in any of the existing pages.
+	/// @param[in] dimensions The dimensions of the rectangle.
+	/// @param[out] page_index The index of the page the rectangle was placed in.
+	/// @param[out] position The position of the top-left corner of the rectangle within the page.
+	/// @return True if the rectangle was allocated.
+	bool Allocate(Vector2i dimensions, int& page_index, Vector2i& position);
+	/// Allocates a batch of rectangles. Either all of the rectangles are allocated, or the atlas is left unchanged.
+	/// @param[in] dimensions The dimensions of each rectangle.
+	/// @param[out] page_indices The index of the page each rectangle was placed in.
+	/// @param[out] positions The position of the top-left corner of each rectangle within its page.
+	/// @return True if all the rectangles were allocated.
+	bool Allocate(const std::vector<Vector2i>& dimensions, std::vector<int>& page_indices, std::vector<Vector2i>& positions);
+
+	/// Returns the number of pages in the atlas.
+	int GetNumPages() const;
+	/// Returns the dimensions of a page.
+	Vector2i GetPageDimensions(int page_index) const;
+
+	/// Returns the region of a page enclosing all rectangles allocated in it since its dirty region was last cleared.
+	/// @return False if no rectangles have been allocated in the page since then.
+	bool GetDirtyRegion(int page_index, Vector2i& region_offset, Vector2i& region_dimensions) const;
+	/// Clears the dirty region of a page.
+	void ClearDirtyRegion(int page_index);
+
+private:
+	struct Shelf {
+		int y;
+		int height;
+		// The horizontal position where the next rectangle will be placed.
+		int x;
+	};
+
+	struct Page {
+		Vector2i dimensions;
+		std::vector<Shelf> shelves;
+		// The vertical position where the next shelf will be opened.
+		int shelf_y;
+		// The corners of the dirty region, empty if the minimum is not less than the maximum.
+		Vector2i dirty_min;
+		Vector2i dirty_max;
+	};
+
+	// Attempts to place a rectangle in the given page, returns true on success.
+	static bool Place(Page& page, Vector2i dimensions, Vector2i& position);
+	// Extends the dirty region of the page to enclose the given rectangle.
+	static void DirtyRegion(Page& page, Vector2i position, Vector2i dimensions);
+
+	Vector2i page_dimensions;
+	std::vector<Page> pages;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,410 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#include "FontGlyphCache.h"
+#include "../Mutex.h"
+#include "../Utilities.h"
+#include "../../../Include/RmlUi/Core/Log.h"
+#include "../../../Include/RmlUi/Core/StringUtilities.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace Rml {
+namespace Core {
+
+// The directory may be set while the font engine is used from other threads.
+static String cache_directory;
+static Mutex cache_directory_mutex;
+
+// Identifies cache files, the version must be incremented whenever the file format or the generated glyphs change.
+static const uint32_t cache_file_magic = 0x434c4752; // "RGLC"
+static const uint32_t cache_file_version = 2;
+
+namespace {
+
+// Appends plain values to a byte buffer.
+class CacheWriter {
+public:
+	template<typename T>
+	void Write(const T& value) {
+		WriteBytes((const byte*)&value, sizeof(T));
+	}
+	void WriteBytes(const byte* data, size_t size) {
+		buffer.insert(buffer.end(), data, data + size);
+	}
+	const std::vector<byte>& GetBuffer() const {
+		return buffer;
+	}
+private:
+	std::vector<byte> buffer;
+};
+
+// Reads plain values from a byte buffer, failing when reading past the end.
+class CacheReader {
+public:
+	CacheReader(const byte* data, size_t size) : position(data), end(data + size) {}
+
+	template<typename T>
+	bool Read(T& value) {
+		const byte* data = ReadBytes(sizeof(T));
+		if (!data)
+			return false;
+		memcpy(&value, data, sizeof(T));
+		return true;
+	}
+	const byte* ReadBytes(size_t size) {
+		if (size > size_t(end - position))
+			return nullptr;
+		const byte* result = position;
+		position += size;
+		return result;
+	}
+private:
+	const byte* position;
+	const byte* end;
+};
+
+}
+
+void FontGlyphCache::SetDirectory(const String& directory)
+{
+	MutexLock lock(cache_directory_mutex);
+	cache_directory = directory;
+}
+
+bool FontGlyphCache::IsEnabled()
+{
+	MutexLock lock(cache_directory_mutex);
+	return !cache_directory.empty();
+}
+
+uint64_t FontGlyphCache::HashFontData(const byte* data, size_t data_size)
+{
+	return Utilities::HashFNV1a(data, data_size);
+}
+
+FontGlyphCache::FontGlyphCache(uint64_t font_hash, int font_size)
+{
+	{
+		MutexLock lock(cache_directory_mutex);
+		file_path = cache_directory;
+	}
+
+	if (!file_path.empty() && file_path.back() != '/' && file_path.back() != '\\')
+		file_path += '/';
+
+	file_path += CreateString(64, "font-%08x%08x-%d.cache", (unsigned int)(font_hash >> 32), (unsigned int)(font_hash & 0xffffffff), font_size);
+}
+
+FontGlyphCache::~FontGlyphCache()
+{}
+
+bool FontGlyphCache::Load(FontGlyphMap& glyphs, FontMetrics& metrics)
+{
+	FILE* file = fopen(file_path.c_str(), "rb");
+	if (!file)
+		return false;
+
+	fseek(file, 0, SEEK_END);
+	const long file_size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	if (file_size <= 0)
+	{
+		fclose(file);
+		return false;
+	}
+
+	file_data.reset(new byte[file_size]);
+	const bool read_result = (fread(file_data.get(), 1, (size_t)file_size, file) == (size_t)file_size);
+	fclose(file);
+
+	CacheReader reader(file_data.get(), (size_t)file_size);
+	FontGlyphMap loaded_glyphs;
+	UnorderedMap<size_t, LayerGlyphMap> loaded_layers;
+
+	auto ReadContents = [&]() -> bool {
+		uint32_t magic = 0, version = 0;
+		if (!reader.Read(magic) || !reader.Read(version) || magic != cache_file_magic || version != cache_file_version)
+			return false;
+
+		FontMetrics loaded_metrics = {};
+		if (!reader.Read(loaded_metrics.size) || !reader.Read(loaded_metrics.x_height) || !reader.Read(loaded_metrics.line_height) ||
+			!reader.Read(loaded_metrics.baseline) || !reader.Read(loaded_metrics.underline_position) || !reader.Read(loaded_metrics.underline_thickness))
+			return false;
+
+		uint32_t num_glyphs = 0;
+		if (!reader.Read(num_glyphs))
+			return false;
+
+		loaded_glyphs.reserve(num_glyphs);
+
+		for (uint32_t i = 0; i < num_glyphs; i++)
+		{
+			uint32_t character = 0;
+			uint8_t has_bitmap = 0;
+			FontGlyph glyph;
+
+			if (!reader.Read(character) || !reader.Read(glyph.dimensions) || !reader.Read(glyph.bearing) || !reader.Read(glyph.advance) ||
+				!reader.Read(glyph.bitmap_dimensions) || !reader.Read(has_bitmap))
+				return false;
+
+			if (has_bitmap)
+			{
+				if (glyph.bitmap_dimensions.x <= 0 || glyph.bitmap_dimensions.y <= 0)
+					return false;
+
+				glyph.bitmap_data = reader.ReadBytes(size_t(glyph.bitmap_dimensions.x * glyph.bitmap_dimensions.y));
+				if (!glyph.bitmap_data)
+					return false;
+			}
+
+			loaded_glyphs[(Character)character] = std::move(glyph);
+		}
+
+		uint32_t num_layers = 0;
+		if (!reader.Read(num_layers))
+			return false;
+
+		for (uint32_t i = 0; i < num_layers; i++)
+		{
+			uint64_t fingerprint = 0;
+			uint32_t num_layer_glyphs = 0;
+			if (!reader.Read(fingerprint) || !reader.Read(num_layer_glyphs))
+				return false;
+
+			LayerGlyphMap& layer = loaded_layers[(size_t)fingerprint];
+
+			for (uint32_t j = 0; j < num_layer_glyphs; j++)
+			{
+				uint32_t character = 0;
+				uint8_t has_geometry = 0;
+				LayerGlyph layer_glyph;
+
+				if (!reader.Read(character) || !reader.Read(has_geometry))
+					return false;
+
+				layer_glyph.has_geometry = (has_geometry != 0);
+
+				if (layer_glyph.has_geometry)
+				{
+					if (!reader.Read(layer_glyph.origin) || !reader.Read(layer_glyph.dimensions) ||
+						layer_glyph.dimensions.x < 0 || layer_glyph.dimensions.y < 0)
+						return false;
+
+					layer_glyph.data = reader.ReadBytes(size_t(layer_glyph.dimensions.x * layer_glyph.dimensions.y * 4));
+					if (!layer_glyph.data)
+						return false;
+				}
+
+				layer[(Character)character] = layer_glyph;
+			}
+		}
+
+		metrics = loaded_metrics;
+		return true;
+	};
+
+	if (!read_result || !ReadContents())
+	{
+		Log::Message(Log::LT_WARNING, "Font cache file '%s' is invalid or out of date, it will be generated again.", file_path.c_str());
+		file_data.reset();
+		dirty = true;
+		return false;
+	}
+
+	glyphs = std::move(loaded_glyphs);
+	layers = std::move(loaded_layers);
+
+	return true;
+}
+
+void FontGlyphCache::Save(const FontGlyphMap& glyphs, const FontMetrics& metrics, const UnorderedSet<Character>& excluded_characters)
+{
+	if (!dirty)
+		return;
+
+	auto IsExcluded = [&excluded_characters](Character character) {
+		return excluded_characters.find(character) != excluded_characters.end();
+	};
+
+	CacheWriter writer;
+	writer.Write(cache_file_magic);
+	writer.Write(cache_file_version);
+
+	writer.Write(metrics.size);
+	writer.Write(metrics.x_height);
+	writer.Write(metrics.line_height);
+	writer.Write(metrics.baseline);
+	writer.Write(metrics.underline_position);
+	writer.Write(metrics.underline_thickness);
+
+	uint32_t num_glyphs = 0;
+	for (auto& pair : glyphs)
+	{
+		if (!IsExcluded(pair.first))
+			num_glyphs += 1;
+	}
+
+	writer.Write(num_glyphs);
+
+	for (auto& pair : glyphs)
+	{
+		if (IsExcluded(pair.first))
+			continue;
+
+		const FontGlyph& glyph = pair.second;
+		const uint8_t has_bitmap = (glyph.bitmap_data && glyph.bitmap_dimensions.x > 0 && glyph.bitmap_dimensions.y > 0 ? 1 : 0);
+
+		writer.Write((uint32_t)pair.first);
+		writer.Write(glyph.dimensions);
+		writer.Write(glyph.bearing);
+		writer.Write(glyph.advance);
+		writer.Write(glyph.bitmap_dimensions);
+		writer.Write(has_bitmap);
+
+		if (has_bitmap)
+			writer.WriteBytes(glyph.bitmap_data, size_t(glyph.bitmap_dimensions.x * glyph.bitmap_dimensions.y));
+	}
+
+	writer.Write((uint32_t)layers.size());
+
+	for (auto& layer_pair : layers)
+	{
+		uint32_t num_layer_glyphs = 0;
+		for (auto& pair : layer_pair.second)
+		{
+			if (!IsExcluded(pair.first))
+				num_layer_glyphs += 1;
+		}
+
+		writer.Write((uint64_t)layer_pair.first);
+		writer.Write(num_layer_glyphs);
+
+		for (auto& pair : layer_pair.second)
+		{
+			if (IsExcluded(pair.first))
+				continue;
+
+			const LayerGlyph& layer_glyph = pair.second;
+
+			writer.Write((uint32_t)pair.first);
+			writer.Write((uint8_t)(layer_glyph.has_geometry ? 1 : 0));
+
+			if (layer_glyph.has_geometry)
+			{
+				writer.Write(layer_glyph.origin);
+				writer.Write(layer_glyph.dimensions);
+				writer.WriteBytes(layer_glyph.data, size_t(layer_glyph.dimensions.x * layer_glyph.dimensions.y * 4));
+			}
+		}
+	}
+
+	// Write to a temporary file first, and then replace the cache file with it. This way, the cache file is never left
+	// partially written, such as when the application is terminated while writing.
+	const String temporary_path = file_path + ".tmp";
+
+	FILE* file = fopen(temporary_path.c_str(), "wb");
+	if (!file)
+	{
+		Log::Message(Log::LT_WARNING, "Unable to write font cache file '%s'.", temporary_path.c_str());
+		return;
+	}
+
+	const std::vector<byte>& buffer = writer.GetBuffer();
+	const bool write_result = (fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size());
+	const bool close_result = (fclose(file) == 0);
+
+	if (!write_result || !close_result)
+	{
+		Log::Message(Log::LT_WARNING, "Unable to write font cache file '%s'.", temporary_path.c_str());
+		remove(temporary_path.c_str());
+		return;
+	}
+
+	// Renaming onto an existing file fails on some platforms, remove it first in that case.
+	if (rename(temporary_path.c_str(), file_path.c_str()) != 0)
+	{
+		remove(file_path.c_str());
+		if (rename(temporary_path.c_str(), file_path.c_str()) != 0)
+		{
+			Log::Message(Log::LT_WARNING, "Unable to replace font cache file '%s'.", file_path.c_str());
+			remove(temporary_path.c_str());
+			return;
+		}
+	}
+
+	dirty = false;
+}
+
+void FontGlyphCache::SetDirty()
+{
+	dirty = true;
+}
+
+bool FontGlyphCache::GetLayerGlyph(size_t fingerprint, Character character, LayerGlyph& layer_glyph) const
+{
+	auto it_layer = layers.find(fingerprint);
+	if (it_layer == layers.end())
+		return false;
+
+	auto it = it_layer->second.find(character);
+	if (it == it_layer->second.end())
+		return false;
+
+	layer_glyph = it->second;
+	return true;
+}
+
+void FontGlyphCache::AddLayerGlyph(size_t fingerprint, Character character, bool has_geometry, Vector2i origin, Vector2i dimensions, const byte* data, int stride)
+{
+	LayerGlyph layer_glyph;
+	layer_glyph.has_geometry = has_geometry;
+
+	if (has_geometry)
+	{
+		layer_glyph.origin = origin;
+		layer_glyph.dimensions = dimensions;
+
+		const int row_size = dimensions.x * 4;
+		UniquePtr<byte[]> glyph_data(new byte[row_size * dimensions.y + 1]);
+
+		for (int y = 0; y < dimensions.y; y++)
+			memcpy(glyph_data.get() + y * row_size, data + y * stride, row_size);
+
+		layer_glyph.data = glyph_data.get();
+		layer_data.push_back(std::move(glyph_data));
+	}
+
+	layers[fingerprint][character] = layer_glyph;
+	dirty = true;
+}
+
+}
+}
@@ -0,0 +1,123 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#ifndef RMLUICOREFONTGLYPHCACHE_H
+#define RMLUICOREFONTGLYPHCACHE_H
+
+#include "../../../Include/RmlUi/Core/FontGlyph.h"
+#include "../../../Include/RmlUi/Core/Traits.h"
+#include "FontTypes.h"
+
+namespace Rml {
+namespace Core {
+
+/**
+	A persistent cache of the glyphs and font effect layers generated for a font face handle.
+
+	The cache is stored in a file in the cache directory, named after a hash of the font data and the font size. When a
+	handle is created, its glyphs and metrics are loaded from the file instead of being rasterized, and the glyph images
+	of its font effect layers are taken from the file instead of being generated again. Loaded glyph data is used
+	directly from the file contents kept in memory. The file is written again by the font provider when new glyphs have
+	been generated, regularly and on shutdown. It is replaced at once, so that it is never left partially written.
+ */
+
+class FontGlyphCache : public NonCopyMoveable
+{
+public:
+	/// Sets the directory to store cache files in, or an empty string to disable the cache.
+	static void SetDirectory(const String& directory);
+	/// Returns true if a cache directory has been set.
+	static bool IsEnabled();
+	/// Returns a hash of the font data, used to identify the font face in the cache.
+	static uint64_t HashFontData(const byte* data, size_t data_size);
+
+	/// Constructs the cache of a font face handle.
+	/// @param[in] font_hash The hash of the font data.
+	/// @param[in] font_size The size of the handle.
+	FontGlyphCache(uint64_t font_hash, int font_size);
+	~FontGlyphCache();
+
+	/// Loads the cache file, if it exists.
+	/// @param[out] glyphs The glyph map to fill with the cached glyphs, which refer to data owned by the cache.
+	/// @param[out] metrics The cached metrics of the font face.
+	/// @return True if the cache file was loaded.
+	bool Load(FontGlyphMap& glyphs, FontMetrics& metrics);
+	/// Writes the cache file, if any new glyphs have been generated.
+	/// @param[in] glyphs The glyphs of the handle.
+	/// @param[in] metrics The metrics of the font face.
+	/// @param[in] excluded_characters Characters to leave out, such as glyphs taken from fallback font faces.
+	void Save(const FontGlyphMap& glyphs, const FontMetrics& metrics, const UnorderedSet<Character>& excluded_characters);
+
+	/// Marks the cache as changed, such as when a glyph is generated, so that it is written when saved.
+	void SetDirty();
+
+	/// The image of a glyph in a font effect layer.
+	struct LayerGlyph {
+		// False if the glyph has no geometry in the layer.
+		bool has_geometry = false;
+		Vector2i origin = Vector2i(0, 0);
+		Vector2i dimensions = Vector2i(0, 0);
+		// The RGBA data of the glyph image, tightly packed.
+		const byte* data = nullptr;
+	};
+
+	/// Looks up the image of a glyph in a font effect layer.
+	/// @param[in] fingerprint The fingerprint of the layer's font effect.
+	/// @param[in] character The character of the glyph.
+	/// @param[out] layer_glyph The cached glyph image.
+	/// @return True if the glyph was found.
+	bool GetLayerGlyph(size_t fingerprint, Character character, LayerGlyph& layer_glyph) const;
+	/// Adds the image of a glyph in a font effect layer to the cache.
+	/// @param[in] fingerprint The fingerprint of the layer's font effect.
+	/// @param[in] character The character of the glyph.
+	/// @param[in] has_geometry False if the glyph has no geometry in the layer, in which case the remaining parameters are unused.
+	/// @param[in] origin The origin of the glyph returned by the font effect.
+	/// @param[in] dimensions The dimensions of the glyph image.
+	/// @param[in] data The RGBA data of the glyph image.
+	/// @param[in] stride The number of bytes between each row of the data.
+	void AddLayerGlyph(size_t fingerprint, Character character, bool has_geometry, Vector2i origin, Vector2i dimensions, const byte* data, int stride);
+
+private:
+	String file_path;
+
+	// The contents of the loaded cache file, glyph and layer data loaded from the file point into it.
+	UniquePtr<byte[]> file_data;
+	// Data of the layer glyphs added since loading.
+	std::vector<UniquePtr<byte[]>> layer_data;
+
+	using LayerGlyphMap = UnorderedMap<Character, LayerGlyph>;
+	UnorderedMap<size_t, LayerGlyphMap> layers;
+
+	bool dirty = false;
+};
+
+}
+}
+
+#endif
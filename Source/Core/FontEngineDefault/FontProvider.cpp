@@ -29,11 +29,13 @@
 #include "FontProvider.h"
 #include "FontFace.h"
 #include "FontFamily.h"
+#include "FontGlyphCache.h"
 #include "FreeTypeInterface.h"
 #include "../../../Include/RmlUi/Core/Core.h"
 #include "../../../Include/RmlUi/Core/FileInterface.h"
 #include "../../../Include/RmlUi/Core/Log.h"
 #include "../../../Include/RmlUi/Core/StringUtilities.h"
+#include "../../../Include/RmlUi/Core/SystemInterface.h"
 #include <algorithm>
 
 namespace Rml {
@@ -41,6 +43,14 @@ namespace Core {
 
 static FontProvider* g_font_provider = nullptr;
 
+// Font faces loaded from files are unloaded when idle for this long, while their font data exceeds the memory budget.
+static size_t font_memory_budget = 32 * 1024 * 1024;
+static double font_idle_time = 30.0;
+// The interval between checks for idle faces.
+static constexpr double font_idle_check_interval = 1.0;
+// The interval between writing the glyph caches, when new glyphs have been generated.
+static constexpr double glyph_cache_save_interval = 5.0;
+
 FontProvider::FontProvider()
 {
 	RMLUI_ASSERT(!g_font_provider);
@@ -63,6 +73,8 @@ bool FontProvider::Initialise()
 void FontProvider::Shutdown()
 {
 	RMLUI_ASSERT(g_font_provider);
+	if (FontGlyphCache::IsEnabled())
+		g_font_provider->WriteGlyphCaches();
 	delete g_font_provider;
 	g_font_provider = nullptr;
 	FreeType::Shutdown();
@@ -87,6 +99,12 @@ FontFaceHandleDefault* FontProvider::GetFontFaceHandle(const String& family, Sty
 	return it->second->GetFaceHandle(style, weight, size);
 }
 
+void FontProvider::SetMemoryBudget(size_t budget, double idle_time)
+{
+	font_memory_budget = budget;
+	font_idle_time = idle_time;
+}
+
 int FontProvider::CountFallbackFontFaces()
 {
 	return (int)Get().fallback_font_faces.size();
@@ -105,24 +123,23 @@ FontFaceHandleDefault* FontProvider::GetFallbackFontFace(int index, int font_siz
 
 bool FontProvider::LoadFontFace(const String& file_name, bool fallback_face)
 {
-	FileInterface* file_interface = GetFileInterface();
-	FileHandle handle = file_interface->Open(file_name);
+	// Only the face properties are read now, the face is loaded from the file when first used.
+	String font_family;
+	Style::FontStyle style = Style::FontStyle::Normal;
+	Style::FontWeight weight = Style::FontWeight::Normal;
+	bool has_kerning = false;
 
-	if (!handle)
+	if (!FreeType::ReadFaceStyle(file_name, font_family, style, weight, has_kerning))
 	{
-		Log::Message(Log::LT_ERROR, "Failed to load font face from %s, could not open file.", file_name.c_str());
+		Log::Message(Log::LT_ERROR, "Failed to load font face from %s, could not read file.", file_name.c_str());
 		return false;
 	}
 
-	size_t length = file_interface->Length(handle);
-
-	byte* buffer = new byte[length];
-	file_interface->Read(buffer, length, handle);
-	file_interface->Close(handle);
+	FontFace* face = Get().AddFace(std::make_unique<FontFace>(file_name, style, weight, has_kerning), font_family, fallback_face);
+	Get().file_font_faces.push_back(face);
 
-	bool result = Get().LoadFontFace(buffer, (int)length, fallback_face, true, file_name);
-
-	return result;
+	Log::Message(Log::LT_INFO, "Registered font face %s (from %s).", font_family.c_str(), file_name.c_str());
+	return true;
 }
 
 
@@ -130,21 +147,18 @@ bool FontProvider::LoadFontFace(const byte* data, int data_size, const String& f
 {
 	const String source = "memory";
 	
-	bool result = Get().LoadFontFace(data, data_size, fallback_face, false, source, font_family, style, weight);
+	bool result = Get().LoadFontFace(data, data_size, fallback_face, source, font_family, style, weight);
 	
 	return result;
 }
 
-bool FontProvider::LoadFontFace(const byte* data, int data_size, bool fallback_face, bool local_data, const String& source,
+bool FontProvider::LoadFontFace(const byte* data, int data_size, bool fallback_face, const String& source,
 	String font_family, Style::FontStyle style, Style::FontWeight weight)
 {
 	FontFaceHandleFreetype ft_face = FreeType::LoadFace(data, data_size, source);
 	
 	if (!ft_face)
 	{
-		if (local_data)
-			delete[] data;
-
 		Log::Message(Log::LT_ERROR, "Failed to load font face %s (from %s).", font_family.c_str(), source.c_str());
 		return false;
 	}
@@ -154,17 +168,13 @@ bool FontProvider::LoadFontFace(const byte* data, int data_size, bool fallback_f
 		FreeType::GetFaceStyle(ft_face, font_family, style, weight);
 	}
 
-	if (!AddFace(ft_face, font_family, style, weight, fallback_face, local_data))
-	{
-		Log::Message(Log::LT_ERROR, "Failed to load font face %s (from %s).", font_family.c_str(), source.c_str());
-		return false;
-	}
+	AddFace(std::make_unique<FontFace>(ft_face, style, weight, false), font_family, fallback_face);
 
 	Log::Message(Log::LT_INFO, "Loaded font face %s (from %s).", font_family.c_str(), source.c_str());
 	return true;
 }
 
-bool FontProvider::AddFace(FontFaceHandleFreetype face, const String& family, Style::FontStyle style, Style::FontWeight weight, bool fallback_face, bool release_stream)
+FontFace* FontProvider::AddFace(UniquePtr<FontFace> face, const String& family, bool fallback_face)
 {
 	String family_lower = StringUtilities::ToLower(family);
 	FontFamily* font_family = nullptr;
@@ -180,9 +190,9 @@ bool FontProvider::AddFace(FontFaceHandleFreetype face, const String& family, St
 		font_families[family_lower] = std::move(font_family_ptr);
 	}
 
-	FontFace* font_face_result = font_family->AddFace(face, style, weight, release_stream);
+	FontFace* font_face_result = font_family->AddFace(std::move(face));
 
-	if (font_face_result && fallback_face)
+	if (fallback_face)
 	{
 		auto it_fallback_face = std::find(fallback_font_faces.begin(), fallback_font_faces.end(), font_face_result);
 		if (it_fallback_face == fallback_font_faces.end())
@@ -191,9 +201,74 @@ bool FontProvider::AddFace(FontFaceHandleFreetype face, const String& family, St
 		}
 	}
 
-	return static_cast<bool>(font_face_result);
+	return font_face_result;
+}
+
+void FontProvider::SaveGlyphCaches()
+{
+	if (!FontGlyphCache::IsEnabled())
+		return;
+
+	const double current_time = GetSystemInterface()->GetElapsedTime();
+	double& last_save_time = Get().last_glyph_cache_save_time;
+	if (current_time - last_save_time < glyph_cache_save_interval)
+		return;
+
+	last_save_time = current_time;
+
+	Get().WriteGlyphCaches();
 }
 
+void FontProvider::WriteGlyphCaches()
+{
+	for (auto& pair : font_families)
+		pair.second->SaveGlyphCaches();
+}
+
+void FontProvider::ReleaseIdleFontFaces()
+{
+	FontFaceList& file_font_faces = Get().file_font_faces;
+	if (file_font_faces.empty())
+		return;
+
+	const double current_time = GetSystemInterface()->GetElapsedTime();
+	double& last_idle_check_time = Get().last_idle_check_time;
+	if (current_time - last_idle_check_time < font_idle_check_interval)
+		return;
+
+	last_idle_check_time = current_time;
+
+	// Find the loaded faces and when they were last used.
+	std::vector<std::pair<double, FontFace*>> loaded_faces;
+	size_t loaded_data_size = 0;
+
+	for (FontFace* face : file_font_faces)
+	{
+		const double last_used_time = face->UpdateLastUsedTime(current_time);
+		if (face->GetLoadedDataSize() > 0)
+		{
+			loaded_faces.emplace_back(last_used_time, face);
+			loaded_data_size += face->GetLoadedDataSize();
+		}
+	}
+
+	if (loaded_data_size <= font_memory_budget)
+		return;
+
+	// Release the least recently used idle faces until we are within the budget.
+	std::sort(loaded_faces.begin(), loaded_faces.end(), [](const std::pair<double, FontFace*>& a, const std::pair<double, FontFace*>& b) {
+		return a.first < b.first;
+	});
+
+	for (auto& pair : loaded_faces)
+	{
+		if (loaded_data_size <= font_memory_budget || current_time - pair.first < font_idle_time)
+			break;
+
+		loaded_data_size -= pair.second->GetLoadedDataSize();
+		pair.second->ReleaseFreeTypeFace();
+	}
+}
 
 }
 }
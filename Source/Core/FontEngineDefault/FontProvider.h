@@ -62,6 +62,7 @@ public:
 	static FontFaceHandleDefault* GetFontFaceHandle(const String& family, Style::FontStyle style, Style::FontWeight weight, int size);
 
 	/// Adds a new font face to the database. The face's family, style and weight will be determined from the face itself.
+	/// Only the face properties are read from the file, the face is loaded when first used.
 	static bool LoadFontFace(const String& file_name, bool fallback_face);
 
 	/// Adds a new font face from memory.
@@ -73,16 +74,33 @@ public:
 	/// Return a font face handle with the given index, at the given font size.
 	static FontFaceHandleDefault* GetFallbackFontFace(int index, int font_size);
 
+	/// Sets the memory budget for faces loaded from files. While their font data exceeds the budget, faces which have
+	/// not been used for the given idle time are unloaded, least recently used first.
+	/// @param[in] budget The budget, in bytes.
+	/// @param[in] idle_time The time in seconds a face must be unused before it can be unloaded.
+	static void SetMemoryBudget(size_t budget, double idle_time);
+	/// Unloads faces loaded from files which have been idle for a while, if they exceed the memory budget. Should be
+	/// called regularly while text is generated, the faces are only checked once every second.
+	static void ReleaseIdleFontFaces();
+
+	/// Writes the glyph caches of the font face handles which generated new glyphs since they were last written, if
+	/// the glyph cache is enabled. Should be called regularly, the caches are only written once every few seconds. They
+	/// are also written on shutdown.
+	static void SaveGlyphCaches();
+
 private:
 	FontProvider();
 	~FontProvider();
 
 	static FontProvider& Get();
 
-	bool LoadFontFace(const byte* data, int data_size, bool fallback_face, bool local_data, const String& source,
+	// Writes the glyph caches of all font families.
+	void WriteGlyphCaches();
+
+	bool LoadFontFace(const byte* data, int data_size, bool fallback_face, const String& source,
 		String font_family = {}, Style::FontStyle style = Style::FontStyle::Normal, Style::FontWeight weight = Style::FontWeight::Normal);
 
-	bool AddFace(FontFaceHandleFreetype face, const String& family, Style::FontStyle style, Style::FontWeight weight, bool fallback_face, bool release_stream);
+	FontFace* AddFace(UniquePtr<FontFace> face, const String& family, bool fallback_face);
 
 	using FontFaceList = std::vector<FontFace*>;
 	using FontFamilyMap = UnorderedMap< String, UniquePtr<FontFamily>>;
@@ -90,6 +108,12 @@ private:
 	FontFamilyMap font_families;
 	FontFaceList fallback_font_faces;
 
+	// Faces loaded from files on demand.
+	FontFaceList file_font_faces;
+	double last_idle_check_time = 0;
+
+	double last_glyph_cache_save_time = 0;
+
 	static const String debugger_font_family_name;
 	
 };
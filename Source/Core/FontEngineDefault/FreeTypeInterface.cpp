@@ -27,8 +27,11 @@
  */
 
 #include "FreeTypeInterface.h"
+#include "../../../Include/RmlUi/Core/Core.h"
+#include "../../../Include/RmlUi/Core/FileInterface.h"
 #include "../../../Include/RmlUi/Core/Log.h"
 
+#include <stdio.h>
 #include <string.h>
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -118,6 +121,70 @@ void FreeType::GetFaceStyle(FontFaceHandleFreetype in_face, String& font_family,
 	weight = face->style_flags & FT_STYLE_FLAG_BOLD ? Style::FontWeight::Bold : Style::FontWeight::Normal;
 }
 
+// Reads from a font file opened through the file interface, called by FreeType for a file stream.
+static unsigned long ReadFileStream(FT_Stream stream, unsigned long offset, unsigned char* buffer, unsigned long count)
+{
+	FileInterface* file_interface = GetFileInterface();
+	FileHandle file = (FileHandle)stream->descriptor.pointer;
+
+	if (!file_interface->Seek(file, (long)offset, SEEK_SET))
+		return (count == 0 ? 1 : 0);
+
+	if (count == 0)
+		return 0;
+
+	return (unsigned long)file_interface->Read(buffer, (size_t)count, file);
+}
+
+bool FreeType::ReadFaceStyle(const String& file_name, String& font_family, Style::FontStyle& style, Style::FontWeight& weight, bool& has_kerning)
+{
+	RMLUI_ASSERT(ft_library);
+
+	FileInterface* file_interface = GetFileInterface();
+	FileHandle file = file_interface->Open(file_name);
+	if (!file)
+		return false;
+
+	// Open the face through a stream reading from the file on demand, so that only the tables needed for the face
+	// properties are read, instead of the whole file.
+	FT_StreamRec stream = {};
+	stream.descriptor.pointer = (void*)file;
+	stream.size = (unsigned long)file_interface->Length(file);
+	stream.read = &ReadFileStream;
+
+	FT_Open_Args args = {};
+	args.flags = FT_OPEN_STREAM;
+	args.stream = &stream;
+
+	FT_Face face = nullptr;
+	FT_Error error = FT_Open_Face(ft_library, &args, 0, &face);
+
+	bool result = false;
+	if (error != 0)
+	{
+		Log::Message(Log::LT_ERROR, "FreeType error %d while reading face from %s.", error, file_name.c_str());
+	}
+	else
+	{
+		GetFaceStyle((FontFaceHandleFreetype)face, font_family, style, weight);
+		has_kerning = HasKerning((FontFaceHandleFreetype)face);
+		result = true;
+		FT_Done_Face(face);
+	}
+
+	file_interface->Close(file);
+
+	return result;
+}
+
+void FreeType::GetFaceData(FontFaceHandleFreetype in_face, const byte*& data, size_t& data_size)
+{
+	FT_Face face = (FT_Face)in_face;
+
+	data = (const byte*)face->stream->base;
+	data_size = (size_t)face->stream->size;
+}
+
 
 
 // Initialises the handle so it is able to render text.
@@ -166,6 +233,13 @@ bool FreeType::AppendGlyph(FontFaceHandleFreetype face, int font_size, Character
 }
 
 
+bool FreeType::HasKerning(FontFaceHandleFreetype face)
+{
+	FT_Face ft_face = (FT_Face)face;
+
+	return FT_HAS_KERNING(ft_face);
+}
+
 int FreeType::GetKerning(FontFaceHandleFreetype face, int font_size, Character lhs, Character rhs)
 {
 	FT_Face ft_face = (FT_Face)face;
@@ -49,12 +49,21 @@ bool ReleaseFace(FontFaceHandleFreetype face, bool release_stream);
 // Retrieves the font family, style and weight of the given font face.
 void GetFaceStyle(FontFaceHandleFreetype face, String& font_family, Style::FontStyle& style, Style::FontWeight& weight);
 
+// Reads the font family, style, weight, and whether the face has kerning from a font file, without loading the whole file.
+bool ReadFaceStyle(const String& file_name, String& font_family, Style::FontStyle& style, Style::FontWeight& weight, bool& has_kerning);
+
+// Retrieves the font data the face was loaded from.
+void GetFaceData(FontFaceHandleFreetype face, const byte*& data, size_t& data_size);
+
 // Initializes a face for a given font size. Glyphs are filled with the ASCII subset, and the font face metrics are set.
 bool InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size, FontGlyphMap& glyphs, FontMetrics& metrics);
 
 // Build a new glyph representing the given code point and append to 'glyphs'.
 bool AppendGlyph(FontFaceHandleFreetype face, int font_size, Character character, FontGlyphMap& glyphs);
 
+// Returns true if the face has kerning information.
+bool HasKerning(FontFaceHandleFreetype face);
+
 // Returns the kerning between two characters.
 int GetKerning(FontFaceHandleFreetype face, int font_size, Character lhs, Character rhs);
 
@@ -27,6 +27,7 @@
  */
 
 #include "../../Include/RmlUi/Core/FontEngineInterface.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
 
 namespace Rml {
 namespace Core {
@@ -96,6 +97,15 @@ int FontEngineInterface::GetStringWidth(FontFaceHandle, const String& RMLUI_UNUS
 	return 0;
 }
 
+bool FontEngineInterface::GetCharacterAdvances(FontFaceHandle, const Character* RMLUI_UNUSED_PARAMETER(string), int RMLUI_UNUSED_PARAMETER(num_characters), int* RMLUI_UNUSED_PARAMETER(advances), Character RMLUI_UNUSED_PARAMETER(prior_character))
+{
+	RMLUI_UNUSED(string);
+	RMLUI_UNUSED(num_characters);
+	RMLUI_UNUSED(advances);
+	RMLUI_UNUSED(prior_character);
+	return false;
+}
+
 int FontEngineInterface::GenerateString(FontFaceHandle, FontEffectsHandle, const String& RMLUI_UNUSED_PARAMETER(string),
 	const Vector2f& RMLUI_UNUSED_PARAMETER(position), const Colourb& RMLUI_UNUSED_PARAMETER(colour), GeometryList& RMLUI_UNUSED_PARAMETER(geometry))
 {
@@ -106,10 +116,20 @@ int FontEngineInterface::GenerateString(FontFaceHandle, FontEffectsHandle, const
 	return 0;
 }
 
+int FontEngineInterface::GenerateCharacterString(FontFaceHandle face_handle, FontEffectsHandle font_effects_handle, const Character* string, int num_characters,
+	const Vector2f& position, const Colourb& colour, GeometryList& geometry)
+{
+	return GenerateString(face_handle, font_effects_handle, StringUtilities::ToUTF8(string, num_characters), position, colour, geometry);
+}
+
 int FontEngineInterface::GetVersion(FontFaceHandle handle)
 {
 	return 0;
 }
 
+void FontEngineInterface::ReleaseIdleResources()
+{
+}
+
 }
 }
@@ -39,12 +39,12 @@
 namespace Rml {
 namespace Core {
 
-Geometry::Geometry(Element* _host_element)
+Geometry::Geometry(Element* _host_element) : host_element(_host_element)
 {
 	database_handle = GeometryDatabase::Insert(this);
 }
 
-Geometry::Geometry(Context* _host_context)
+Geometry::Geometry(Context* _host_context) : host_context(_host_context)
 {
 	database_handle = GeometryDatabase::Insert(this);
 }
@@ -72,7 +72,11 @@ void Geometry::MoveFrom(Geometry& other)
 
 	texture = std::exchange(other.texture, nullptr);
 
+	atlas_vertices = std::move(other.atlas_vertices);
+	atlas_version = std::exchange(other.atlas_version, -1);
+
 	compiled_geometry = std::exchange(other.compiled_geometry, 0);
+	compiled_texture_handle = std::exchange(other.compiled_texture_handle, 0);
 	compile_attempted = std::exchange(other.compile_attempted, false);
 }
 
@@ -104,6 +108,23 @@ void Geometry::Render(const Vector2f& translation)
 	if (render_interface == nullptr)
 		return;
 
+	// Geometry is rendered as nothing while its texture is being loaded asynchronously.
+	if (texture != nullptr && texture->IsLoading(render_interface))
+		return;
+
+	// Textures packed into the atlas provide their handle along with their region, so that the atlas is only queried once.
+	TextureHandle texture_handle = 0;
+	const std::vector< Vertex >& render_vertices = (texture != nullptr ? UpdateAtlasVertices(render_interface, texture_handle) : vertices);
+
+	// The texture may have been released and loaded again, such as when over the texture memory budget, the geometry
+	// must then be compiled again with its new handle.
+	if (compiled_geometry && texture_handle != compiled_texture_handle)
+	{
+		render_interface->ReleaseCompiledGeometry(compiled_geometry);
+		compiled_geometry = 0;
+		compile_attempted = false;
+	}
+
 	// Render our compiled geometry if possible.
 	if (compiled_geometry)
 	{
@@ -114,7 +135,7 @@ void Geometry::Render(const Vector2f& translation)
 	// immediate mode.
 	else
 	{
-		if (vertices.empty() ||
+		if (render_vertices.empty() ||
 			indices.empty())
 			return;
 
@@ -123,7 +144,8 @@ void Geometry::Render(const Vector2f& translation)
 		if (!compile_attempted)
 		{
 			compile_attempted = true;
-			compiled_geometry = render_interface->CompileGeometry(&vertices[0], (int) vertices.size(), &indices[0], (int) indices.size(), texture != nullptr ? texture->GetHandle(GetRenderInterface()) : 0);
+			compiled_geometry = render_interface->CompileGeometry((Vertex*) &render_vertices[0], (int) render_vertices.size(), &indices[0], (int) indices.size(), texture_handle);
+			compiled_texture_handle = texture_handle;
 
 			// If we managed to compile the geometry, we can clear the local copy of vertices and indices and
 			// immediately render the compiled version.
@@ -136,7 +158,7 @@ void Geometry::Render(const Vector2f& translation)
 
 		// Either we've attempted to compile before (and failed), or the compile we just attempted failed; either way,
 		// render the uncompiled version.
-		render_interface->RenderGeometry(&vertices[0], (int) vertices.size(), &indices[0], (int) indices.size(), texture != nullptr ? texture->GetHandle(GetRenderInterface()) : 0, translation);
+		render_interface->RenderGeometry((Vertex*) &render_vertices[0], (int) render_vertices.size(), &indices[0], (int) indices.size(), texture_handle, translation);
 	}
 }
 
@@ -175,11 +197,48 @@ void Geometry::Release(bool clear_buffers)
 
 	compile_attempted = false;
 
+	// The vertices may have changed, remap them to the texture atlas again on next render.
+	atlas_version = -1;
+
 	if (clear_buffers)
 	{
 		vertices.clear();
 		indices.clear();
+		atlas_vertices.clear();
+	}
+}
+
+const std::vector< Vertex >& Geometry::UpdateAtlasVertices(RenderInterface* render_interface, TextureHandle& handle)
+{
+	Vector2f texcoord_offset, texcoord_scale;
+	int version = 0;
+
+	if (!texture->GetAtlasRegion(render_interface, texcoord_offset, texcoord_scale, version, handle))
+	{
+		handle = texture->GetHandle(render_interface);
+
+		if (!atlas_vertices.empty())
+		{
+			Release();
+			atlas_vertices.clear();
+		}
+
+		return vertices;
 	}
+
+	// The region of the texture has changed since we last remapped, or the geometry has been modified.
+	if (version != atlas_version || atlas_vertices.size() != vertices.size())
+	{
+		Release();
+
+		atlas_vertices = vertices;
+		for (Vertex& vertex : atlas_vertices)
+			vertex.tex_coord = texcoord_offset + vertex.tex_coord * texcoord_scale;
+
+		atlas_version = version;
+	}
+
+	return atlas_vertices;
 }
 
 // Returns the host context's render interface.
@@ -28,6 +28,7 @@
 
 #include "GeometryDatabase.h"
 #include "../../Include/RmlUi/Core/Geometry.h"
+#include "Mutex.h"
 #include <algorithm>
 
 namespace Rml {
@@ -106,19 +107,23 @@ private:
 
 
 static Database geometry_database;
+static Mutex geometry_database_mutex;
 
 GeometryDatabaseHandle Insert(Geometry* geometry)
 {
+	MutexLock lock(geometry_database_mutex);
 	return geometry_database.insert(geometry);
 }
 
 void Erase(GeometryDatabaseHandle handle)
 {
+	MutexLock lock(geometry_database_mutex);
 	geometry_database.erase(handle);
 }
 
 void ReleaseAll()
 {
+	MutexLock lock(geometry_database_mutex);
 	geometry_database.for_each([](Geometry* geometry) {
 		geometry->Release();
 	});
@@ -66,7 +66,7 @@ LayoutInlineBox* LayoutInlineBoxText::FlowContent(bool first_box, float availabl
 
 	int line_length;
 	float line_width;
-	bool overflow = !text_element->GenerateLine(line_contents, line_length, line_width, line_begin, available_width, right_spacing_width, first_box, true);
+	bool overflow = !text_element->GenerateCharacterLine(line_contents, line_length, line_width, line_begin, available_width, right_spacing_width, first_box, true);
 
 	Vector2f content_area;
 	content_area.x = line_width;
@@ -114,11 +114,11 @@ void LayoutInlineBoxText::PositionElement()
 		LayoutInlineBox::PositionElement();
 
 		GetTextElement()->ClearLines();
-		GetTextElement()->AddLine(Vector2f(0, 0), line_contents);
+		GetTextElement()->AddCharacterLine(Vector2f(0, 0), line_contents);
 	}
 	else
 	{
-		GetTextElement()->AddLine(line->GetRelativePosition() + position - element->GetRelativeOffset(Box::BORDER), line_contents);
+		GetTextElement()->AddCharacterLine(line->GetRelativePosition() + position - element->GetRelativeOffset(Box::BORDER), line_contents);
 	}
 }
 
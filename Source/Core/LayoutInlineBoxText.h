@@ -85,8 +85,8 @@ private:
 
 	// The index of the first character of this line.
 	int line_begin;
-	// The contents on this line.
-	String line_contents;
+	// The code points on this line.
+	std::vector< Character > line_contents;
 
 	// True if this line can be segmented into parts, false if it consists of only a single word.
 	bool line_segmented;
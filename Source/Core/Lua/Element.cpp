@@ -40,6 +40,40 @@ namespace Core {
 namespace Lua {
 typedef ElementDocument Document;
 
+//Pushes the proxy of the given type for the element. Proxies are kept in a weak table by element, so that repeated
+//accesses such as element.style.width reuse the proxy while it is still referenced instead of allocating a new one.
+template<typename ProxyType>
+static void PushElementProxy(lua_State* L, Element* element)
+{
+    luaL_getmetatable(L,GetTClassName<ProxyType>()); //->[1] = metatable of the proxy type
+    lua_getfield(L,-1,"__proxies"); //->[2] = weak table of proxies by element
+    if(lua_isnil(L,-1))
+    {
+        lua_pop(L,1); //pop the nil
+        lua_newtable(L);
+        lua_newtable(L);
+        lua_pushstring(L,"v");
+        lua_setfield(L,-2,"__mode");
+        lua_setmetatable(L,-2);
+        lua_pushvalue(L,-1);
+        lua_setfield(L,-3,"__proxies");
+    }
+    lua_pushlightuserdata(L,element);
+    lua_rawget(L,-2); //->[3] = the existing proxy, or nil
+    if(lua_isnil(L,-1))
+    {
+        lua_pop(L,1); //pop the nil
+        ProxyType* proxy = new ProxyType();
+        proxy->owner = element;
+        LuaType<ProxyType>::push(L,proxy,true); //->[3] = the new proxy
+        lua_pushlightuserdata(L,element);
+        lua_pushvalue(L,-2);
+        lua_rawset(L,-4); //[2][element] = [3]
+    }
+    lua_insert(L,-3); //move the proxy below the metatable and the table
+    lua_pop(L,2);
+}
+
 template<> void ExtraInit<Element>(lua_State* L, int metatable_index)
 {
     int top = lua_gettop(L);
@@ -261,6 +295,25 @@ int ElementSetAttribute(lua_State* L, Element* obj)
     return 0;
 }
 
+int ElementSetAttributes(lua_State* L, Element* obj)
+{
+    //all attributes are set in a single call, so that the element only processes the changes once
+    luaL_checktype(L,1,LUA_TTABLE);
+    ElementAttributes attributes;
+    lua_pushnil(L);
+    while(lua_next(L,1) != 0)
+    {
+        //[2] = key, [3] = value; the key must not be converted in place as it is used by lua_next
+        luaL_checktype(L,2,LUA_TSTRING);
+        const char* name = lua_tostring(L,2);
+        const char* value = luaL_checkstring(L,3);
+        attributes[name] = Variant(String(value));
+        lua_pop(L,1); //pop the value, keep the key for the next iteration
+    }
+    obj->SetAttributes(attributes);
+    return 0;
+}
+
 int ElementSetClass(lua_State* L, Element* obj)
 {
     const char* name = luaL_checkstring(L,1);
@@ -269,14 +322,28 @@ int ElementSetClass(lua_State* L, Element* obj)
     return 0;
 }
 
+int ElementSetProperties(lua_State* L, Element* obj)
+{
+    luaL_checktype(L,1,LUA_TTABLE);
+    lua_pushnil(L);
+    while(lua_next(L,1) != 0)
+    {
+        //[2] = key, [3] = value; the key must not be converted in place as it is used by lua_next
+        luaL_checktype(L,2,LUA_TSTRING);
+        const char* name = lua_tostring(L,2);
+        const char* value = luaL_checkstring(L,3);
+        obj->SetProperty(name,value);
+        lua_pop(L,1); //pop the value, keep the key for the next iteration
+    }
+    return 0;
+}
+
 //getters
 int ElementGetAttrattributes(lua_State* L)
 {
     Element* ele = LuaType<Element>::check(L,1);
     LUACHECKOBJ(ele);
-    ElementAttributesProxy* proxy = new ElementAttributesProxy();
-    proxy->owner = ele;
-    LuaType<ElementAttributesProxy>::push(L,proxy,true);    
+    PushElementProxy<ElementAttributesProxy>(L,ele);
     return 1;
 }
 
@@ -284,9 +351,7 @@ int ElementGetAttrchild_nodes(lua_State* L)
 {
     Element* ele = LuaType<Element>::check(L,1);
     LUACHECKOBJ(ele);
-    ElementChildNodesProxy* ecnp = new ElementChildNodesProxy();
-    ecnp->owner = ele;
-    LuaType<ElementChildNodesProxy>::push(L,ecnp,true);
+    PushElementProxy<ElementChildNodesProxy>(L,ele);
     return 1;
 }
 
@@ -493,9 +558,7 @@ int ElementGetAttrstyle(lua_State* L)
 {
     Element* ele = LuaType<Element>::check(L,1);
     LUACHECKOBJ(ele);
-    ElementStyleProxy* prox = new ElementStyleProxy();
-    prox->owner = ele;
-    LuaType<ElementStyleProxy>::push(L,prox,true);
+    PushElementProxy<ElementStyleProxy>(L,ele);
     return 1;
 }
 
@@ -577,7 +640,9 @@ RegType<Element> ElementMethods[] =
     LUAMETHOD(Element,ReplaceChild)
     LUAMETHOD(Element,ScrollIntoView)
     LUAMETHOD(Element,SetAttribute)
+    LUAMETHOD(Element,SetAttributes)
     LUAMETHOD(Element,SetClass)
+    LUAMETHOD(Element,SetProperties)
     { nullptr, nullptr },
 };
 
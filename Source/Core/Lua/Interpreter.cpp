@@ -34,6 +34,7 @@
 #include <RmlUi/Core/Lua/LuaType.h>
 #include "LuaDocumentElementInstancer.h"
 #include <RmlUi/Core/Factory.h>
+#include "LuaEventListener.h"
 #include "LuaEventListenerInstancer.h"
 #include "RmlUi.h"
 //the types I made
@@ -180,6 +181,11 @@ void Interpreter::EndCall(int res)
     }
 }
 
+int Interpreter::GetEventListenerCompileCount()
+{
+    return LuaEventListener::GetNumCompiledFunctions();
+}
+
 
 //From Plugin
 int Interpreter::GetEventClasses()
@@ -37,6 +37,8 @@ namespace Core {
 namespace Lua {
 typedef Rml::Core::ElementDocument Document;
 
+static int num_compiled_functions = 0;
+
 LuaEventListener::LuaEventListener(const String& code, Element* element) : EventListener()
 {
     //compose function
@@ -57,22 +59,47 @@ LuaEventListener::LuaEventListener(const String& code, Element* element) : Event
     }
     int tbl = lua_gettop(L);
 
-    //compile,execute,and save the function
-    if(luaL_loadstring(L,function.c_str()) != 0)
+    //functions are compiled once per code string, and then shared between all listeners with the same code
+    lua_getglobal(L,"EVENTLISTENERCODECACHE");
+    if(lua_isnoneornil(L,-1))
     {
-        Report(L);
-        return;
+        lua_pop(L,1); //pop the unsucessful getglobal
+        lua_newtable(L);
+        lua_pushvalue(L,-1);
+        lua_setglobal(L,"EVENTLISTENERCODECACHE");
     }
-    else
+    int cache = lua_gettop(L);
+
+    lua_pushlstring(L,function.c_str(),function.size());
+    lua_rawget(L,cache);
+    if(lua_isnil(L,-1))
     {
-        if(lua_pcall(L,0,1,0) != 0)
+        lua_pop(L,1); //pop the nil
+
+        //compile,execute,and save the function
+        if(luaL_loadstring(L,function.c_str()) != 0)
         {
             Report(L);
+            lua_settop(L,top);
             return;
         }
+        else
+        {
+            if(lua_pcall(L,0,1,0) != 0)
+            {
+                Report(L);
+                lua_settop(L,top);
+                return;
+            }
+        }
+        num_compiled_functions++;
+
+        lua_pushlstring(L,function.c_str(),function.size());
+        lua_pushvalue(L,-2);
+        lua_rawset(L,cache);
     }
     luaFuncRef = luaL_ref(L,tbl); //creates a reference to the item at the top of the stack in to the table we just created
-    lua_pop(L,1); //pop the EVENTLISTENERFUNCTIONS table
+    lua_pop(L,2); //pop the EVENTLISTENERCODECACHE and EVENTLISTENERFUNCTIONS tables
 
     attached = element;
 	if(element)
@@ -123,6 +150,11 @@ void LuaEventListener::OnDetach(Element* element)
 	delete this;
 }
 
+int LuaEventListener::GetNumCompiledFunctions()
+{
+	return num_compiled_functions;
+}
+
 /// Process the incoming Event
 void LuaEventListener::ProcessEvent(Event& event)
 {
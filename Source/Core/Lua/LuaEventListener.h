@@ -57,6 +57,9 @@ public:
 	// Calls the associated Lua function.
 	void ProcessEvent(Event& event) override;
 
+	// Returns the number of functions compiled from code strings, listeners with identical code share a single function.
+	static int GetNumCompiledFunctions();
+
 private:
     //the lua-side function to call when ProcessEvent is called
     int luaFuncRef = -1;
@@ -0,0 +1,64 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUICOREMUTEX_H
+#define RMLUICOREMUTEX_H
+
+#include <mutex>
+
+namespace Rml {
+namespace Core {
+
+/**
+	Mutex used to guard the state shared between contexts, such as caches and memory pools.
+
+	When built with RMLUI_THREAD_SAFE_CONTEXTS, different contexts may be updated concurrently from separate threads,
+	and the shared state is guarded by a real mutex. Otherwise, locking the mutex does nothing.
+ */
+
+#ifdef RMLUI_THREAD_SAFE_CONTEXTS
+
+using Mutex = std::mutex;
+
+#else
+
+class Mutex
+{
+public:
+	void lock() {}
+	void unlock() {}
+};
+
+#endif
+
+using MutexLock = std::lock_guard< Mutex >;
+
+}
+}
+
+#endif
@@ -33,6 +33,7 @@
 #include "../../Include/RmlUi/Core/Debug.h"
 #include "../../Include/RmlUi/Core/Traits.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "Mutex.h"
 
 namespace Rml {
 namespace Core {
@@ -148,6 +149,9 @@ private:
 	PoolNode* first_free_node;
 
 	int num_allocated_objects;
+
+	// Guards the linked lists, objects are constructed and destroyed outside the lock.
+	Mutex mutex;
 };
 
 }
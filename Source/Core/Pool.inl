@@ -93,47 +93,54 @@ template<typename PoolType>
 template<typename ...Args>
 inline PoolType* Pool<PoolType>::AllocateAndConstruct(Args&&... args)
 {
-	// We can't allocate a new object if the deallocated list is empty.
-	if (first_free_node == nullptr)
+	PoolNode* allocated_object = nullptr;
+
 	{
-		// Attempt to grow the pool first.
-		if (grow)
+		MutexLock lock(mutex);
+
+		// We can't allocate a new object if the deallocated list is empty.
+		if (first_free_node == nullptr)
 		{
-			CreateChunk();
-			if (first_free_node == nullptr)
+			// Attempt to grow the pool first.
+			if (grow)
+			{
+				CreateChunk();
+				if (first_free_node == nullptr)
+					return nullptr;
+			}
+			else
 				return nullptr;
 		}
-		else
-			return nullptr;
-	}
 
-	// We're about to allocate an object.
-	++num_allocated_objects;
+		// We're about to allocate an object.
+		++num_allocated_objects;
 
-	// This one!
-	PoolNode* allocated_object = first_free_node;
+		// This one!
+		allocated_object = first_free_node;
 
-	// Remove the newly allocated object from the list of deallocated objects.
-	first_free_node = first_free_node->next;
-	if (first_free_node != nullptr)
-		first_free_node->previous = nullptr;
+		// Remove the newly allocated object from the list of deallocated objects.
+		first_free_node = first_free_node->next;
+		if (first_free_node != nullptr)
+			first_free_node->previous = nullptr;
 
-	// Add the newly allocated object to the head of the list of allocated objects.
-	if (first_allocated_node != nullptr)
-	{
-		allocated_object->previous = nullptr;
-		allocated_object->next = first_allocated_node;
-		first_allocated_node->previous = allocated_object;
-	}
-	else
-	{
-		// This object is the only allocated object.
-		allocated_object->previous = nullptr;
-		allocated_object->next = nullptr;
-	}
+		// Add the newly allocated object to the head of the list of allocated objects.
+		if (first_allocated_node != nullptr)
+		{
+			allocated_object->previous = nullptr;
+			allocated_object->next = first_allocated_node;
+			first_allocated_node->previous = allocated_object;
+		}
+		else
+		{
+			// This object is the only allocated object.
+			allocated_object->previous = nullptr;
+			allocated_object->next = nullptr;
+		}
 
-	first_allocated_node = allocated_object;
+		first_allocated_node = allocated_object;
+	}
 
+	// Constructed outside the lock, as the object may itself allocate from the same pool.
 	return new (allocated_object->object) PoolType(std::forward<Args>(args)...);
 }
 
@@ -141,12 +148,16 @@ inline PoolType* Pool<PoolType>::AllocateAndConstruct(Args&&... args)
 template < typename PoolType >
 void Pool< PoolType >::DestroyAndDeallocate(Iterator& iterator)
 {
-	// We're about to deallocate an object.
-	--num_allocated_objects;
-
 	PoolNode* object = iterator.node;
+
+	// Destroyed outside the lock, as the object may itself deallocate from the same pool.
 	reinterpret_cast<PoolType*>(object->object)->~PoolType();
 
+	MutexLock lock(mutex);
+
+	// We're about to deallocate an object.
+	--num_allocated_objects;
+
 	// Get the previous and next pointers now, because they will be overwritten
 	// before we're finished.
 	PoolNode* previous_object = object->previous;
@@ -0,0 +1,471 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../../Include/RmlUi/Core/RenderCommandBuffer.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "Mutex.h"
+#include "TextureDatabase.h"
+#include <condition_variable>
+#include <mutex>
+
+namespace Rml {
+namespace Core {
+
+struct RenderCommandBuffer::Synchronization {
+	std::mutex mutex;
+	std::condition_variable replayed;
+	// Guards the buffer being recorded, contexts may record into it concurrently while they are updated.
+	Mutex recording_mutex;
+};
+
+RenderCommandBuffer::RenderCommandBuffer(RenderInterface* render_interface, const TextureDimensionsCallback& dimensions_callback) :
+	render_interface(render_interface), dimensions_callback(dimensions_callback), synchronization(std::make_unique<Synchronization>())
+{
+	RMLUI_ASSERT(render_interface);
+	recording_buffer = 0;
+	recording_context = nullptr;
+	last_geometry_handle = 0;
+	last_texture_handle = 0;
+	destroying = false;
+	update_textures = true;
+	update_texture_failed = false;
+	submitted = false;
+}
+
+RenderCommandBuffer::~RenderCommandBuffer()
+{
+	// No more commands will be replayed, so release our textures directly instead of recording their release.
+	destroying = true;
+	TextureDatabase::ReleaseTextures(this);
+
+	for (auto& pair : textures)
+	{
+		if (pair.second)
+			render_interface->ReleaseTexture(pair.second);
+	}
+
+	for (auto& pair : compiled_geometry)
+	{
+		if (pair.second.handle)
+			render_interface->ReleaseCompiledGeometry(pair.second.handle);
+	}
+}
+
+void RenderCommandBuffer::Submit()
+{
+	RMLUI_ZoneScoped;
+
+	bool release_textures = false;
+	{
+		MutexLock recording_lock(synchronization->recording_mutex);
+		std::unique_lock<std::mutex> lock(synchronization->mutex);
+		synchronization->replayed.wait(lock, [this] { return !submitted; });
+
+		recording_buffer = 1 - recording_buffer;
+		submitted = true;
+
+		if (update_texture_failed && update_textures)
+		{
+			update_textures = false;
+			release_textures = true;
+		}
+
+		// The context is recorded again at the start of the next buffer.
+		recording_context = nullptr;
+	}
+
+	// Some textures were not updated and are now outdated. Release them all, so that they are generated again from their
+	// complete data as they are used. Any failed updates already submitted are covered by these releases as well.
+	if (release_textures)
+		TextureDatabase::ReleaseTextures(this);
+}
+
+bool RenderCommandBuffer::Replay()
+{
+	RMLUI_ZoneScoped;
+
+	Buffer* buffer = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(synchronization->mutex);
+		if (!submitted)
+			return false;
+
+		buffer = &buffers[1 - recording_buffer];
+	}
+
+	// The submitted buffer is not touched by the recording thread until we mark it as replayed.
+	for (const Command& command : buffer->commands)
+		ExecuteCommand(*buffer, command);
+
+	render_interface->context = nullptr;
+
+	buffer->commands.clear();
+	buffer->vertices.clear();
+	buffer->indices.clear();
+	buffer->transforms.clear();
+	buffer->texture_data.clear();
+	buffer->texture_sources.clear();
+
+	{
+		std::lock_guard<std::mutex> lock(synchronization->mutex);
+		submitted = false;
+	}
+	synchronization->replayed.notify_all();
+
+	return true;
+}
+
+void RenderCommandBuffer::RenderGeometry(Vertex* vertices, int num_vertices, int* indices, int num_indices, TextureHandle texture, const Vector2f& translation)
+{
+	MutexLock lock(synchronization->recording_mutex);
+
+	Command& command = AddCommand(CommandType::RenderGeometry);
+	AddGeometry(command, vertices, num_vertices, indices, num_indices);
+	command.texture = texture;
+	command.translation = translation;
+}
+
+CompiledGeometryHandle RenderCommandBuffer::CompileGeometry(Vertex* vertices, int num_vertices, int* indices, int num_indices, TextureHandle texture)
+{
+	MutexLock lock(synchronization->recording_mutex);
+
+	// The geometry is compiled during replay, the handle we return refers to the result.
+	Command& command = AddCommand(CommandType::CompileGeometry);
+	AddGeometry(command, vertices, num_vertices, indices, num_indices);
+	command.texture = texture;
+	command.geometry = ++last_geometry_handle;
+	return command.geometry;
+}
+
+void RenderCommandBuffer::RenderCompiledGeometry(CompiledGeometryHandle geometry, const Vector2f& translation)
+{
+	MutexLock lock(synchronization->recording_mutex);
+
+	Command& command = AddCommand(CommandType::RenderCompiledGeometry);
+	command.geometry = geometry;
+	command.translation = translation;
+}
+
+void RenderCommandBuffer::ReleaseCompiledGeometry(CompiledGeometryHandle geometry)
+{
+	MutexLock lock(synchronization->recording_mutex);
+
+	Command& command = AddCommand(CommandType::ReleaseCompiledGeometry);
+	command.geometry = geometry;
+}
+
+void RenderCommandBuffer::EnableScissorRegion(bool enable)
+{
+	MutexLock lock(synchronization->recording_mutex);
+
+	Command& command = AddCommand(CommandType::EnableScissorRegion);
+	command.size[0] = (enable ? 1 : 0);
+}
+
+void RenderCommandBuffer::SetScissorRegion(int x, int y, int width, int height)
+{
+	MutexLock lock(synchronization->recording_mutex);
+
+	Command& command = AddCommand(CommandType::SetScissorRegion);
+	command.offset[0] = x;
+	command.offset[1] = y;
+	command.size[0] = width;
+	command.size[1] = height;
+}
+
+bool RenderCommandBuffer::LoadTexture(TextureHandle& texture_handle, Vector2i& texture_dimensions, const String& source)
+{
+	MutexLock lock(synchronization->recording_mutex);
+
+	// Without the dimensions callback, the texture must be loaded right away to know its dimensions. The handle we
+	// return is still our own, so that all handles are resolved in the same way during replay.
+	if (!dimensions_callback)
+	{
+		TextureHandle loaded_texture = 0;
+		if (!render_interface->LoadTexture(loaded_texture, texture_dimensions, source))
+			return false;
+
+		Command& command = AddCommand(CommandType::AddLoadedTexture);
+		command.texture = ++last_texture_handle;
+		command.loaded_texture = loaded_texture;
+
+		texture_handle = command.texture;
+		return true;
+	}
+
+	if (!dimensions_callback(source, texture_dimensions))
+		return false;
+
+	Buffer& buffer = buffers[recording_buffer];
+
+	Command& command = AddCommand(CommandType::LoadTexture);
+	command.texture = ++last_texture_handle;
+	command.offset[0] = (int)buffer.texture_sources.size();
+	buffer.texture_sources.push_back(source);
+
+	texture_handle = command.texture;
+	return true;
+}
+
+bool RenderCommandBuffer::GenerateTexture(TextureHandle& texture_handle, const byte* source, const Vector2i& source_dimensions)
+{
+	MutexLock lock(synchronization->recording_mutex);
+
+	Buffer& buffer = buffers[recording_buffer];
+
+	// The texture is generated during replay, thus we keep a copy of its data until then.
+	Command& command = AddCommand(CommandType::GenerateTexture);
+	command.texture = ++last_texture_handle;
+	command.offset[0] = (int)buffer.texture_data.size();
+	command.size[0] = source_dimensions.x;
+	command.size[1] = source_dimensions.y;
+	buffer.texture_data.insert(buffer.texture_data.end(), source, source + source_dimensions.x * source_dimensions.y * 4);
+
+	texture_handle = command.texture;
+	return true;
+}
+
+bool RenderCommandBuffer::UpdateTexture(TextureHandle texture_handle, const Vector2i& region_offset, const Vector2i& region_dimensions, const byte* source, int source_stride)
+{
+	MutexLock lock(synchronization->recording_mutex);
+
+	// The texture is then released instead and generated again.
+	if (!update_textures)
+		return false;
+
+	Buffer& buffer = buffers[recording_buffer];
+
+	// Copy the rows of the region tightly packed, the source stride refers to the caller's data.
+	Command& command = AddCommand(CommandType::UpdateTexture);
+	command.texture = texture_handle;
+	command.region_offset = region_offset;
+	command.offset[0] = (int)buffer.texture_data.size();
+	command.size[0] = region_dimensions.x;
+	command.size[1] = region_dimensions.y;
+
+	const int row_size = region_dimensions.x * 4;
+	for (int y = 0; y < region_dimensions.y; y++)
+	{
+		const byte* row = source + y * source_stride;
+		buffer.texture_data.insert(buffer.texture_data.end(), row, row + row_size);
+	}
+
+	return true;
+}
+
+void RenderCommandBuffer::ReleaseTexture(TextureHandle texture)
+{
+	MutexLock lock(synchronization->recording_mutex);
+
+	if (destroying)
+	{
+		auto it = textures.find(texture);
+		if (it != textures.end())
+		{
+			if (it->second)
+				render_interface->ReleaseTexture(it->second);
+			textures.erase(it);
+		}
+		return;
+	}
+
+	// The texture may still be used by commands waiting to be replayed.
+	Command& command = AddCommand(CommandType::ReleaseTexture);
+	command.texture = texture;
+}
+
+void RenderCommandBuffer::SetTransform(const Matrix4f* transform)
+{
+	MutexLock lock(synchronization->recording_mutex);
+
+	Buffer& buffer = buffers[recording_buffer];
+
+	Command& command = AddCommand(CommandType::SetTransform);
+	if (transform)
+	{
+		command.transform = (int)buffer.transforms.size();
+		buffer.transforms.push_back(*transform);
+	}
+}
+
+RenderCommandBuffer::Command& RenderCommandBuffer::AddCommand(CommandType type)
+{
+	Buffer& buffer = buffers[recording_buffer];
+
+	// The context is set by the context currently rendering through us.
+	Context* context = GetContext();
+	if (context != recording_context)
+	{
+		recording_context = context;
+
+		Command context_command;
+		context_command.type = CommandType::SetContext;
+		context_command.context = context;
+		buffer.commands.push_back(context_command);
+	}
+
+	Command command;
+	command.type = type;
+	buffer.commands.push_back(command);
+
+	return buffer.commands.back();
+}
+
+void RenderCommandBuffer::AddGeometry(Command& command, const Vertex* vertices, int num_vertices, const int* indices, int num_indices)
+{
+	Buffer& buffer = buffers[recording_buffer];
+
+	command.offset[0] = (int)buffer.vertices.size();
+	command.size[0] = num_vertices;
+	buffer.vertices.insert(buffer.vertices.end(), vertices, vertices + num_vertices);
+
+	command.offset[1] = (int)buffer.indices.size();
+	command.size[1] = num_indices;
+	buffer.indices.insert(buffer.indices.end(), indices, indices + num_indices);
+}
+
+void RenderCommandBuffer::ExecuteCommand(const Buffer& buffer, const Command& command)
+{
+	// The application's render interface takes non-const pointers, although it should not modify the data.
+	Vertex* vertices = const_cast<Vertex*>(buffer.vertices.data()) + command.offset[0];
+	int* indices = const_cast<int*>(buffer.indices.data()) + command.offset[1];
+
+	switch (command.type)
+	{
+	case CommandType::SetContext:
+		render_interface->context = command.context;
+		break;
+	case CommandType::RenderGeometry:
+		render_interface->RenderGeometry(vertices, command.size[0], indices, command.size[1], GetTexture(command.texture), command.translation);
+		break;
+	case CommandType::CompileGeometry:
+	{
+		CompiledGeometry& geometry = compiled_geometry[command.geometry];
+		geometry.texture = GetTexture(command.texture);
+		geometry.handle = render_interface->CompileGeometry(vertices, command.size[0], indices, command.size[1], geometry.texture);
+
+		// Keep our own copy if the application could not compile the geometry, so that we can render it directly.
+		if (!geometry.handle)
+		{
+			geometry.vertices.assign(vertices, vertices + command.size[0]);
+			geometry.indices.assign(indices, indices + command.size[1]);
+		}
+	}
+	break;
+	case CommandType::RenderCompiledGeometry:
+	{
+		auto it = compiled_geometry.find(command.geometry);
+		if (it == compiled_geometry.end())
+			break;
+
+		CompiledGeometry& geometry = it->second;
+		if (geometry.handle)
+			render_interface->RenderCompiledGeometry(geometry.handle, command.translation);
+		else if (!geometry.vertices.empty() && !geometry.indices.empty())
+			render_interface->RenderGeometry(geometry.vertices.data(), (int)geometry.vertices.size(), geometry.indices.data(), (int)geometry.indices.size(), geometry.texture, command.translation);
+	}
+	break;
+	case CommandType::ReleaseCompiledGeometry:
+	{
+		auto it = compiled_geometry.find(command.geometry);
+		if (it == compiled_geometry.end())
+			break;
+
+		if (it->second.handle)
+			render_interface->ReleaseCompiledGeometry(it->second.handle);
+		compiled_geometry.erase(it);
+	}
+	break;
+	case CommandType::EnableScissorRegion:
+		render_interface->EnableScissorRegion(command.size[0] != 0);
+		break;
+	case CommandType::SetScissorRegion:
+		render_interface->SetScissorRegion(command.offset[0], command.offset[1], command.size[0], command.size[1]);
+		break;
+	case CommandType::SetTransform:
+		render_interface->SetTransform(command.transform >= 0 ? &buffer.transforms[command.transform] : nullptr);
+		break;
+	case CommandType::LoadTexture:
+	{
+		TextureHandle handle = 0;
+		Vector2i dimensions;
+		if (!render_interface->LoadTexture(handle, dimensions, buffer.texture_sources[command.offset[0]]))
+			handle = 0;
+		textures[command.texture] = handle;
+	}
+	break;
+	case CommandType::AddLoadedTexture:
+		textures[command.texture] = command.loaded_texture;
+		break;
+	case CommandType::GenerateTexture:
+	{
+		TextureHandle handle = 0;
+		if (!render_interface->GenerateTexture(handle, buffer.texture_data.data() + command.offset[0], Vector2i(command.size[0], command.size[1])))
+			handle = 0;
+		textures[command.texture] = handle;
+	}
+	break;
+	case CommandType::UpdateTexture:
+	{
+		TextureHandle handle = GetTexture(command.texture);
+		if (!handle)
+			break;
+
+		const Vector2i dimensions(command.size[0], command.size[1]);
+		if (!render_interface->UpdateTexture(handle, command.region_offset, dimensions, buffer.texture_data.data() + command.offset[0], dimensions.x * 4))
+			update_texture_failed = true;
+	}
+	break;
+	case CommandType::ReleaseTexture:
+	{
+		auto it = textures.find(command.texture);
+		if (it == textures.end())
+			break;
+
+		if (it->second)
+			render_interface->ReleaseTexture(it->second);
+		textures.erase(it);
+	}
+	break;
+	}
+}
+
+TextureHandle RenderCommandBuffer::GetTexture(TextureHandle texture) const
+{
+	if (!texture)
+		return 0;
+
+	auto it = textures.find(texture);
+	if (it == textures.end())
+		return 0;
+
+	return it->second;
+}
+
+}
+}
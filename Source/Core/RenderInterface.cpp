@@ -87,6 +87,18 @@ bool RenderInterface::GenerateTexture(TextureHandle& RMLUI_UNUSED_PARAMETER(text
 	return false;
 }
 
+// Called by RmlUi when a region of a generated texture is to be replaced by new pixels.
+bool RenderInterface::UpdateTexture(TextureHandle RMLUI_UNUSED_PARAMETER(texture_handle), const Vector2i& RMLUI_UNUSED_PARAMETER(region_offset), const Vector2i& RMLUI_UNUSED_PARAMETER(region_dimensions), const byte* RMLUI_UNUSED_PARAMETER(source), int RMLUI_UNUSED_PARAMETER(source_stride))
+{
+	RMLUI_UNUSED(texture_handle);
+	RMLUI_UNUSED(region_offset);
+	RMLUI_UNUSED(region_dimensions);
+	RMLUI_UNUSED(source);
+	RMLUI_UNUSED(source_stride);
+
+	return false;
+}
+
 // Called by RmlUi when a loaded texture is no longer required.
 void RenderInterface::ReleaseTexture(TextureHandle RMLUI_UNUSED_PARAMETER(texture))
 {
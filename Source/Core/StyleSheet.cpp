@@ -28,6 +28,7 @@
 
 #include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "ElementDefinition.h"
+#include "Mutex.h"
 #include "StringCache.h"
 #include "StyleSheetFactory.h"
 #include "StyleSheetNode.h"
@@ -46,6 +47,8 @@
 namespace Rml {
 namespace Core {
 
+static Mutex node_cache_mutex;
+
 // Sorts style nodes based on specificity.
 inline static bool StyleSheetNodeSort(const StyleSheetNode* lhs, const StyleSheetNode* rhs)
 {
@@ -288,12 +291,22 @@ FontEffectsPtr StyleSheet::InstanceFontEffectsFromString(const String& font_effe
 			SharedPtr<FontEffect> font_effect = instancer->InstanceFontEffect(type, properties);
 			if (font_effect)
 			{
-				// Create a unique hash value for the given type and values
-				size_t fingerprint = std::hash<String>{}(type);
+				// Create a unique hash value for the given type and values. The fingerprint also identifies the font effect
+				// in the glyph cache stored on disk, thus the hash must not change between runs. The values are hashed in
+				// the order of their ids, as the iteration order of the properties is unspecified.
+				std::vector<PropertyId> property_ids;
 				for (const auto& id_value : properties.GetProperties())
-					Utilities::HashCombine(fingerprint, id_value.second.Get<String>());
+					property_ids.push_back(id_value.first);
+				std::sort(property_ids.begin(), property_ids.end());
 
-				font_effect->SetFingerprint(fingerprint);
+				uint64_t fingerprint = Utilities::HashFNV1a(type.c_str(), type.size() + 1);
+				for (PropertyId id : property_ids)
+				{
+					const String value = properties.GetProperty(id)->Get<String>();
+					fingerprint = Utilities::HashFNV1a(value.c_str(), value.size() + 1, fingerprint);
+				}
+
+				font_effect->SetFingerprint((size_t)fingerprint);
 
 				font_effects.list.emplace_back(std::move(font_effect));
 			}
@@ -329,8 +342,9 @@ SharedPtr<ElementDefinition> StyleSheet::GetElementDefinition(const Element* ele
 	RMLUI_ASSERT_NONRECURSIVE;
 
 	// See if there are any styles defined for this element.
-	// Using static to avoid allocations. Make sure we don't call this function recursively.
-	static std::vector< const StyleSheetNode* > applicable_nodes;
+	// Using static to avoid allocations. Make sure we don't call this function recursively. Thread local, as separate
+	// contexts may be updated concurrently.
+	static thread_local std::vector< const StyleSheetNode* > applicable_nodes;
 	applicable_nodes.clear();
 
 	const String& tag = element->GetTagName();
@@ -384,6 +398,9 @@ SharedPtr<ElementDefinition> StyleSheet::GetElementDefinition(const Element* ele
 	for (const StyleSheetNode* node : applicable_nodes)
 		Utilities::HashCombine(seed, node);
 
+	// Style sheets may be shared between documents of different contexts.
+	MutexLock lock(node_cache_mutex);
+
 	auto cache_iterator = node_cache.find(seed);
 	if (cache_iterator != node_cache.end())
 	{
@@ -45,6 +45,14 @@ void Texture::Set(const String& name, const TextureCallback& callback)
 	resource->Set(name, callback);
 }
 
+bool Texture::Update(const Vector2i& region_offset, const Vector2i& region_dimensions, const byte* source, int source_stride)
+{
+	if (!resource)
+		return true;
+
+	return resource->Update(region_offset, region_dimensions, source, source_stride);
+}
+
 // Returns the texture's source name. This is usually the name of the file the texture was loaded from.
 const String& Texture::GetSource() const
 {
@@ -73,6 +81,28 @@ Vector2i Texture::GetDimensions(RenderInterface* render_interface) const
 	return resource->GetDimensions(render_interface);
 }
 
+bool Texture::GetAtlasRegion(RenderInterface* render_interface, Vector2f& texcoord_offset, Vector2f& texcoord_scale, int& version, TextureHandle& handle) const
+{
+	if (!resource)
+		return false;
+
+	return resource->GetAtlasRegion(render_interface, texcoord_offset, texcoord_scale, version, handle);
+}
+
+bool Texture::IsLoading(RenderInterface* render_interface) const
+{
+	if (!resource)
+		return false;
+
+	return resource->IsLoading(render_interface);
+}
+
+void Texture::AddLoadListener(Element* element) const
+{
+	if (resource)
+		resource->AddLoadListener(element);
+}
+
 bool Texture::operator==(const Texture& other) const
 {
 	return resource == other.resource;
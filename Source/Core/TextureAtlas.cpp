@@ -0,0 +1,401 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#include "TextureAtlas.h"
+#include "TextureResource.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
+#include <algorithm>
+#include <string.h>
+
+namespace Rml {
+namespace Core {
+
+static TextureAtlas* texture_atlas = nullptr;
+
+static bool atlas_enabled = false;
+static TextureCallback atlas_decode_callback;
+static int atlas_max_texture_size = 64;
+static int atlas_max_page_size = 1024;
+
+// Textures are padded by their edge pixels on each side, so that filtering at their edges does not sample neighbouring textures.
+static constexpr int atlas_padding = 1;
+
+// The size of new pages, they grow as textures are added until they reach the maximum page size.
+static constexpr int atlas_initial_page_size = 256;
+
+TextureAtlas::TextureAtlas()
+{
+	RMLUI_ASSERT(texture_atlas == nullptr);
+	texture_atlas = this;
+}
+
+TextureAtlas::~TextureAtlas()
+{
+	RMLUI_ASSERT(texture_atlas == this);
+	texture_atlas = nullptr;
+}
+
+void TextureAtlas::Initialise()
+{
+	new TextureAtlas();
+}
+
+void TextureAtlas::Shutdown()
+{
+	delete texture_atlas;
+}
+
+void TextureAtlas::Enable(const TextureCallback& decode_callback, int max_texture_size, int max_page_size)
+{
+	atlas_enabled = static_cast<bool>(decode_callback);
+	atlas_decode_callback = decode_callback;
+	atlas_max_texture_size = max_texture_size;
+	atlas_max_page_size = max_page_size;
+}
+
+bool TextureAtlas::IsEnabled()
+{
+	return atlas_enabled && texture_atlas;
+}
+
+bool TextureAtlas::Decode(const String& source, UniquePtr<const byte[]>& data, Vector2i& dimensions)
+{
+	if (!atlas_decode_callback)
+		return false;
+
+	return atlas_decode_callback(source, data, dimensions);
+}
+
+bool TextureAtlas::CanAddTexture(const Vector2i& dimensions)
+{
+	const int max_size = Math::Min(atlas_max_texture_size, atlas_max_page_size - 2 * atlas_padding);
+
+	return dimensions.x > 0 && dimensions.y > 0 && dimensions.x <= max_size && dimensions.y <= max_size;
+}
+
+void TextureAtlas::AddTexture(TextureResource* texture, UniquePtr<const byte[]> data, const Vector2i& dimensions)
+{
+	RMLUI_ASSERT(texture_atlas && CanAddTexture(dimensions));
+	MutexLock lock(texture_atlas->mutex);
+
+	// Replace any previous texture of the resource, its region becomes free once its page is emptied.
+	texture_atlas->RemoveEntry(texture);
+
+	Entry& entry = texture_atlas->entries[texture];
+	entry.data = std::move(data);
+	entry.dimensions = dimensions;
+
+	texture_atlas->Place(texture, entry);
+}
+
+void TextureAtlas::RemoveTexture(TextureResource* texture)
+{
+	if (!texture_atlas)
+		return;
+
+	MutexLock lock(texture_atlas->mutex);
+	texture_atlas->RemoveEntry(texture);
+}
+
+TextureHandle TextureAtlas::GetHandle(TextureResource* texture, RenderInterface* render_interface)
+{
+	if (!texture_atlas)
+		return 0;
+
+	MutexLock lock(texture_atlas->mutex);
+
+	auto it = texture_atlas->entries.find(texture);
+	if (it == texture_atlas->entries.end())
+		return 0;
+
+	const int page_index = it->second.page_index;
+	texture_atlas->UploadPendingEntries(page_index);
+
+	return texture_atlas->pages[page_index].texture.GetHandle(render_interface);
+}
+
+bool TextureAtlas::GetRegion(TextureResource* texture, RenderInterface* render_interface, Vector2f& texcoord_offset, Vector2f& texcoord_scale, int& version, TextureHandle& handle)
+{
+	if (!texture_atlas)
+		return false;
+
+	MutexLock lock(texture_atlas->mutex);
+
+	auto it = texture_atlas->entries.find(texture);
+	if (it == texture_atlas->entries.end())
+		return false;
+
+	const Entry& entry = it->second;
+	Page& page = texture_atlas->pages[entry.page_index];
+
+	texcoord_offset.x = float(entry.position.x + atlas_padding) / float(page.dimensions.x);
+	texcoord_offset.y = float(entry.position.y + atlas_padding) / float(page.dimensions.y);
+	texcoord_scale.x = float(entry.dimensions.x) / float(page.dimensions.x);
+	texcoord_scale.y = float(entry.dimensions.y) / float(page.dimensions.y);
+	version = entry.version;
+
+	texture_atlas->UploadPendingEntries(entry.page_index);
+	handle = page.texture.GetHandle(render_interface);
+
+	return true;
+}
+
+TextureAtlasStatistics TextureAtlas::GetStatistics()
+{
+	TextureAtlasStatistics statistics;
+
+	if (!texture_atlas)
+		return statistics;
+
+	MutexLock lock(texture_atlas->mutex);
+
+	for (auto& pair : texture_atlas->entries)
+	{
+		statistics.num_textures += 1;
+		statistics.used_pixels += pair.second.dimensions.x * pair.second.dimensions.y;
+	}
+
+	for (const Page& page : texture_atlas->pages)
+		statistics.page_pixels += page.dimensions.x * page.dimensions.y;
+
+	statistics.num_pages = (int)texture_atlas->pages.size();
+
+	return statistics;
+}
+
+void TextureAtlas::RemoveEntry(TextureResource* texture)
+{
+	auto it = entries.find(texture);
+	if (it == entries.end())
+		return;
+
+	Page& page = pages[it->second.page_index];
+	page.pending_entries.erase(std::remove(page.pending_entries.begin(), page.pending_entries.end(), texture), page.pending_entries.end());
+
+	// The space of removed textures is only reclaimed once their page is empty, as the other textures never move.
+	page.num_entries -= 1;
+	if (page.num_entries == 0)
+	{
+		page.shelves.clear();
+		page.shelf_y = 0;
+	}
+
+	entries.erase(it);
+}
+
+void TextureAtlas::Place(TextureResource* texture, Entry& entry)
+{
+	const Vector2i padded_dimensions = entry.dimensions + Vector2i(2 * atlas_padding);
+
+	int page_index = -1;
+	for (int i = 0; i < (int)pages.size() && page_index < 0; i++)
+	{
+		do {
+			if (PlaceOnPage(pages[i], padded_dimensions, entry.position))
+			{
+				page_index = i;
+				break;
+			}
+		} while (GrowPage(i));
+	}
+
+	if (page_index < 0)
+	{
+		// The texture is small enough for a page, see CanAddTexture(), thus it always fits on a new page.
+		const int initial_size = Math::Min(atlas_max_page_size, Math::Max(atlas_initial_page_size, Math::ToPowerOfTwo(Math::Max(padded_dimensions.x, padded_dimensions.y))));
+
+		pages.emplace_back();
+		pages.back().dimensions = Vector2i(initial_size);
+		page_index = (int)pages.size() - 1;
+		ResetPageTexture(page_index);
+
+		bool result = PlaceOnPage(pages.back(), padded_dimensions, entry.position);
+		RMLUI_ASSERT(result);
+		(void)result;
+	}
+
+	Page& page = pages[page_index];
+	page.num_entries += 1;
+	page.pending_entries.push_back(texture);
+
+	entry.page_index = page_index;
+	entry.version = next_version++;
+}
+
+bool TextureAtlas::PlaceOnPage(Page& page, Vector2i dimensions, Vector2i& position)
+{
+	const bool fits_new_shelf = (page.shelf_y + dimensions.y <= page.dimensions.y && dimensions.x <= page.dimensions.x);
+
+	// Find the shelf with the least height to spare among those with room for the rectangle.
+	Shelf* best_shelf = nullptr;
+	for (Shelf& shelf : page.shelves)
+	{
+		if (shelf.height >= dimensions.y && shelf.x + dimensions.x <= page.dimensions.x)
+		{
+			if (!best_shelf || shelf.height < best_shelf->height)
+				best_shelf = &shelf;
+		}
+	}
+
+	// Prefer opening a new shelf over wasting more than half the height of an existing one.
+	if (best_shelf && fits_new_shelf && best_shelf->height - dimensions.y > dimensions.y / 2)
+		best_shelf = nullptr;
+
+	if (!best_shelf)
+	{
+		if (!fits_new_shelf)
+			return false;
+
+		page.shelves.push_back(Shelf{ page.shelf_y, dimensions.y, 0 });
+		page.shelf_y += dimensions.y;
+		best_shelf = &page.shelves.back();
+	}
+
+	position = Vector2i(best_shelf->x, best_shelf->y);
+	best_shelf->x += dimensions.x;
+
+	return true;
+}
+
+bool TextureAtlas::GrowPage(int page_index)
+{
+	Page& page = pages[page_index];
+
+	if (page.dimensions.x >= atlas_max_page_size && page.dimensions.y >= atlas_max_page_size)
+		return false;
+
+	if (page.dimensions.x <= page.dimensions.y && page.dimensions.x < atlas_max_page_size)
+		page.dimensions.x = Math::Min(page.dimensions.x * 2, atlas_max_page_size);
+	else
+		page.dimensions.y = Math::Min(page.dimensions.y * 2, atlas_max_page_size);
+
+	// The textures keep their position, but their texture coordinates change with the size of the page.
+	for (auto& pair : entries)
+	{
+		if (pair.second.page_index == page_index)
+			pair.second.version = next_version++;
+	}
+
+	// The page is generated again from all its textures.
+	page.pending_entries.clear();
+	ResetPageTexture(page_index);
+
+	return true;
+}
+
+void TextureAtlas::ResetPageTexture(int page_index)
+{
+	pages[page_index].texture.Set(CreateString(32, "?atlas::%d", page_index), [this, page_index](const String& /*name*/, UniquePtr<const byte[]>& data, Vector2i& dimensions) {
+		return GeneratePage(page_index, data, dimensions);
+	});
+}
+
+void TextureAtlas::UploadPendingEntries(int page_index)
+{
+	Page& page = pages[page_index];
+	if (page.pending_entries.empty())
+		return;
+
+	std::vector<byte> region_data;
+
+	for (TextureResource* texture : page.pending_entries)
+	{
+		const Entry& entry = entries[texture];
+		const Vector2i region_dimensions = entry.dimensions + Vector2i(2 * atlas_padding);
+		const int region_stride = region_dimensions.x * 4;
+
+		region_data.resize(region_stride * region_dimensions.y);
+		CopyPadded(entry, region_data.data(), region_stride);
+
+		// Render interfaces which have not generated the page yet are unaffected. Those which cannot update textures
+		// release the page instead, it is then generated again with all its textures.
+		if (!page.texture.Update(entry.position, region_dimensions, region_data.data(), region_stride))
+			break;
+	}
+
+	page.pending_entries.clear();
+}
+
+bool TextureAtlas::GeneratePage(int page_index, UniquePtr<const byte[]>& data, Vector2i& dimensions) const
+{
+	if (page_index < 0 || page_index >= (int)pages.size())
+		return false;
+
+	dimensions = pages[page_index].dimensions;
+	const int stride = dimensions.x * 4;
+
+	UniquePtr<byte[]> page_data(new byte[stride * dimensions.y]);
+
+	// Set the page to transparent white.
+	for (int i = 0; i < dimensions.x * dimensions.y; i++)
+	{
+		byte* pixel = page_data.get() + i * 4;
+		pixel[0] = 255;
+		pixel[1] = 255;
+		pixel[2] = 255;
+		pixel[3] = 0;
+	}
+
+	for (auto& pair : entries)
+	{
+		const Entry& entry = pair.second;
+		if (entry.page_index == page_index)
+			CopyPadded(entry, page_data.get() + entry.position.y * stride + entry.position.x * 4, stride);
+	}
+
+	data = std::move(page_data);
+	return true;
+}
+
+void TextureAtlas::CopyPadded(const Entry& entry, byte* destination, int stride)
+{
+	const int row_size = entry.dimensions.x * 4;
+	const byte* source = entry.data.get();
+	byte* destination_texture = destination + atlas_padding * stride + atlas_padding * 4;
+
+	for (int y = 0; y < entry.dimensions.y; y++)
+	{
+		byte* destination_row = destination_texture + y * stride;
+		const byte* source_row = source + y * row_size;
+
+		memcpy(destination_row, source_row, row_size);
+
+		// Extend the edge pixels into the padding.
+		memcpy(destination_row - 4, source_row, 4);
+		memcpy(destination_row + row_size, source_row + row_size - 4, 4);
+	}
+
+	// Extend the top and bottom rows, including the padding corners.
+	memcpy(destination_texture - stride - 4, destination_texture - 4, row_size + 8);
+	memcpy(destination_texture + entry.dimensions.y * stride - 4, destination_texture + (entry.dimensions.y - 1) * stride - 4, row_size + 8);
+}
+
+}
+}
@@ -0,0 +1,152 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#ifndef RMLUICORETEXTUREATLAS_H
+#define RMLUICORETEXTUREATLAS_H
+
+#include "../../Include/RmlUi/Core/Texture.h"
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "Mutex.h"
+#include <deque>
+
+namespace Rml {
+namespace Core {
+
+class TextureResource;
+
+/**
+	The texture atlas packs small textures loaded from a source into shared textures, so that geometry using different
+	images can be rendered without switching textures.
+
+	Textures are decoded by the application through the callback set when enabling the atlas, and placed on shelves of
+	the atlas pages as they are added. Placed textures never move. Pages grow until they reach the maximum page size,
+	after which new pages are added. Textures added to a page which has already been generated are uploaded into it as
+	sub-regions when the page is next used. Geometry using packed textures remaps its texture coordinates to the
+	texture's region on its page, see Texture::GetAtlasRegion().
+ */
+
+class TextureAtlas : public NonCopyMoveable
+{
+public:
+	static void Initialise();
+	static void Shutdown();
+
+	/// Enables the texture atlas, see Rml::Core::EnableTextureAtlas().
+	static void Enable(const TextureCallback& decode_callback, int max_texture_size, int max_page_size);
+	/// Returns true if the texture atlas is enabled.
+	static bool IsEnabled();
+
+	/// Decodes a texture from its source using the application's callback.
+	/// @return True if the texture was decoded.
+	static bool Decode(const String& source, UniquePtr<const byte[]>& data, Vector2i& dimensions);
+	/// Returns true if a texture of the given dimensions is small enough to be packed into the atlas.
+	static bool CanAddTexture(const Vector2i& dimensions);
+
+	/// Adds a texture to the atlas.
+	/// @param[in] texture The texture resource to add.
+	/// @param[in] data The RGBA data of the texture, owned by the atlas from now on.
+	/// @param[in] dimensions The dimensions of the texture.
+	static void AddTexture(TextureResource* texture, UniquePtr<const byte[]> data, const Vector2i& dimensions);
+	/// Removes a texture from the atlas.
+	static void RemoveTexture(TextureResource* texture);
+
+	/// Returns the handle of the atlas page containing the texture, generating the page if necessary.
+	static TextureHandle GetHandle(TextureResource* texture, RenderInterface* render_interface);
+	/// Returns the region of the texture on its atlas page, the version of the region, and the handle of the page.
+	static bool GetRegion(TextureResource* texture, RenderInterface* render_interface, Vector2f& texcoord_offset, Vector2f& texcoord_scale, int& version, TextureHandle& handle);
+
+	/// Returns the statistics of the atlas.
+	static TextureAtlasStatistics GetStatistics();
+
+private:
+	TextureAtlas();
+	~TextureAtlas();
+
+	struct Entry {
+		UniquePtr<const byte[]> data;
+		Vector2i dimensions;
+
+		int page_index = -1;
+		// The position of the texture's padded rectangle on its page.
+		Vector2i position;
+		// Changed whenever the region of the texture changes, such as when its page grows.
+		int version = 0;
+	};
+
+	struct Shelf {
+		int y;
+		int height;
+		// The horizontal position where the next texture will be placed.
+		int x;
+	};
+
+	struct Page {
+		Texture texture;
+		Vector2i dimensions;
+		std::vector<Shelf> shelves;
+		// The vertical position where the next shelf will be opened.
+		int shelf_y = 0;
+		int num_entries = 0;
+		// Textures placed on the page since it was last used, they are uploaded into the page on its next use.
+		std::vector<TextureResource*> pending_entries;
+	};
+
+	// Removes the entry of a texture, if any.
+	void RemoveEntry(TextureResource* texture);
+	// Places a texture on the first page with room for it, growing the pages or adding a new page as necessary.
+	void Place(TextureResource* texture, Entry& entry);
+	// Attempts to place a padded rectangle on a shelf of the page.
+	static bool PlaceOnPage(Page& page, Vector2i dimensions, Vector2i& position);
+	// Doubles the width or height of a page, up to the maximum page size. The page is then generated again.
+	bool GrowPage(int page_index);
+	// Sets the texture of a page, it is generated on its next use.
+	void ResetPageTexture(int page_index);
+
+	// Uploads the textures placed on a page since it was last used, as sub-regions of the page.
+	void UploadPendingEntries(int page_index);
+
+	// Generates the data of an atlas page from its textures.
+	bool GeneratePage(int page_index, UniquePtr<const byte[]>& data, Vector2i& dimensions) const;
+	// Copies the texture of an entry to the destination, padded by its edge pixels.
+	static void CopyPadded(const Entry& entry, byte* destination, int stride);
+
+	UnorderedMap<TextureResource*, Entry> entries;
+
+	// Pages are only referred to by their index, their addresses must however remain valid for their callbacks.
+	std::deque<Page> pages;
+
+	int next_version = 1;
+
+	Mutex mutex;
+};
+
+}
+}
+
+#endif
@@ -27,16 +27,25 @@
  */
 
 #include "TextureDatabase.h"
+#include "TextureAtlas.h"
+#include "TextureLoader.h"
 #include "TextureResource.h"
 #include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/StringUtilities.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
+#include <algorithm>
+#include <atomic>
 
 namespace Rml {
 namespace Core {
 
 static TextureDatabase* texture_database = nullptr;
 
+static size_t texture_memory_budget = 0;
+static int texture_idle_frames = 60;
+static std::atomic<int> current_frame(0);
+
 TextureDatabase::TextureDatabase()
 {
 	RMLUI_ASSERT(texture_database == nullptr);
@@ -52,11 +61,16 @@ TextureDatabase::~TextureDatabase()
 void TextureDatabase::Initialise()
 {
 	new TextureDatabase();
+	TextureAtlas::Initialise();
+	TextureLoader::Initialise();
 }
 
 void TextureDatabase::Shutdown()
 {
+	// Stop decoding textures before they are destroyed.
+	TextureLoader::Shutdown();
 	delete texture_database;
+	TextureAtlas::Shutdown();
 }
 
 // If the requested texture is already in the database, it will be returned with an extra reference count. If not, it
@@ -69,6 +83,8 @@ SharedPtr<TextureResource> TextureDatabase::Fetch(const String& source, const St
 	else
 		GetSystemInterface()->JoinPath(path, StringUtilities::Replace(source_directory, '|', ':'), source);
 
+	MutexLock lock(texture_database->mutex);
+
 	TextureMap::iterator iterator = texture_database->textures.find(path);
 	if (iterator != texture_database->textures.end())
 	{
@@ -85,19 +101,157 @@ SharedPtr<TextureResource> TextureDatabase::Fetch(const String& source, const St
 void TextureDatabase::AddCallbackTexture(TextureResource* texture)
 {
 	if (texture_database)
+	{
+		MutexLock lock(texture_database->mutex);
 		texture_database->callback_textures.insert(texture);
+	}
 }
 
 void TextureDatabase::RemoveCallbackTexture(TextureResource* texture)
 {
 	if (texture_database)
+	{
+		MutexLock lock(texture_database->mutex);
 		texture_database->callback_textures.erase(texture);
+	}
+}
+
+void TextureDatabase::SetMemoryBudget(size_t budget, int idle_frames)
+{
+	texture_memory_budget = budget;
+	texture_idle_frames = Math::Max(idle_frames, 0);
+}
+
+int TextureDatabase::GetFrame()
+{
+	return current_frame;
+}
+
+void TextureDatabase::BeginContextRender(RenderInterface* render_interface, int& context_frame)
+{
+	if (!texture_database)
+		return;
+
+	{
+		MutexLock lock(texture_database->mutex);
+
+		// The context has already rendered in the current frame, thus the application has moved on to the next frame.
+		if (context_frame == current_frame)
+			current_frame++;
+
+		context_frame = current_frame;
+	}
+
+	ReleaseIdleTextures(render_interface);
+}
+
+void TextureDatabase::ReleaseIdleTextures(RenderInterface* render_interface)
+{
+	if (texture_memory_budget == 0)
+		return;
+
+	RMLUI_ZoneScoped;
+
+	// Textures no longer referenced by any element are removed from the database, but only destroyed once the lock is
+	// released. Destroying a texture locks the database and the texture atlas, which must never be locked while the
+	// atlas is locked by another thread.
+	std::vector< SharedPtr<TextureResource> > removed_textures;
+
+	MutexLock lock(texture_database->mutex);
+
+	struct Candidate {
+		TextureResource* texture;
+		size_t memory_size;
+		// Only set for textures loaded from a source, callback textures are owned elsewhere.
+		bool owned;
+	};
+	std::vector<Candidate> candidates;
+	size_t memory_usage = 0;
+
+	const int frame = current_frame;
+
+	auto add_texture = [&](TextureResource* texture, bool owned) {
+		memory_usage += texture->GetMemorySize();
+
+		// Textures used recently are likely used by visible elements, only consider the idle ones for release. Textures
+		// are only released from the render interface of the calling context, as the others may be used by other threads.
+		const size_t memory_size = texture->GetMemorySize(render_interface);
+		if (memory_size > 0 && frame - texture->GetLastUsedFrame() > texture_idle_frames)
+			candidates.push_back(Candidate{ texture, memory_size, owned });
+	};
+
+	for (const auto& texture : texture_database->textures)
+		add_texture(texture.second.get(), true);
+
+	for (TextureResource* texture : texture_database->callback_textures)
+		add_texture(texture, false);
+
+	if (memory_usage <= texture_memory_budget)
+		return;
+
+	std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+		return a.texture->GetLastUsedFrame() < b.texture->GetLastUsedFrame();
+	});
+
+	for (const Candidate& candidate : candidates)
+	{
+		if (memory_usage <= texture_memory_budget)
+			break;
+
+		// The texture is loaded again when next used.
+		candidate.texture->Evict(render_interface);
+		memory_usage -= candidate.memory_size;
+
+		if (candidate.owned)
+		{
+			auto it = texture_database->textures.find(candidate.texture->GetSource());
+			if (it != texture_database->textures.end() && it->second.use_count() == 1)
+			{
+				removed_textures.push_back(std::move(it->second));
+				texture_database->textures.erase(it);
+			}
+		}
+	}
+}
+
+std::vector<ResidentTexture> TextureDatabase::GetResidentTextures()
+{
+	std::vector<ResidentTexture> result;
+
+	if (!texture_database)
+		return result;
+
+	MutexLock lock(texture_database->mutex);
+
+	const int frame = current_frame;
+
+	auto add_texture = [&](TextureResource* texture) {
+		ResidentTexture resident_texture;
+		resident_texture.memory_size = texture->GetMemorySize();
+		if (resident_texture.memory_size == 0)
+			return;
+
+		resident_texture.source = texture->GetSource();
+		resident_texture.dimensions = texture->GetResidentDimensions();
+		resident_texture.idle_frames = frame - texture->GetLastUsedFrame();
+		result.push_back(std::move(resident_texture));
+	};
+
+	for (const auto& texture : texture_database->textures)
+		add_texture(texture.second.get());
+
+	for (TextureResource* texture : texture_database->callback_textures)
+		add_texture(texture);
+
+	return result;
 }
 
 void TextureDatabase::ReleaseTextures(RenderInterface* render_interface)
 {
 	if (texture_database)
 	{
+		MutexLock lock(texture_database->mutex);
+
 		for (const auto& texture : texture_database->textures)
 			texture.second->Release(render_interface);
 
@@ -29,7 +29,9 @@
 #ifndef RMLUICORETEXTUREDATABASE_H
 #define RMLUICORETEXTUREDATABASE_H
 
+#include "../../Include/RmlUi/Core/Texture.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "Mutex.h"
 
 namespace Rml {
 namespace Core {
@@ -62,15 +64,33 @@ public:
     /// Removes a callback texture from the database.
     static void RemoveCallbackTexture(TextureResource* texture);
 
+	/// Sets the memory budget for textures, see Rml::Core::SetTextureMemoryBudget().
+	static void SetMemoryBudget(size_t budget, int idle_frames);
+	/// Returns the current frame, used to track when textures were last used.
+	static int GetFrame();
+	/// Called by each context before it renders. A new frame begins when a context renders for the second time in the
+	/// current frame, so that the frame is shared by all contexts. The least recently used textures of the context's
+	/// render interface are then released while over the memory budget.
+	/// @param[in] render_interface The render interface of the context, only its textures are released.
+	/// @param[in,out] context_frame The frame the context was last rendered in.
+	static void BeginContextRender(RenderInterface* render_interface, int& context_frame);
+	/// Returns the textures currently holding texture handles.
+	static std::vector<ResidentTexture> GetResidentTextures();
+
 private:
 	TextureDatabase();
 	~TextureDatabase();
 
+	// Releases the least recently used textures of a render interface while over the memory budget.
+	static void ReleaseIdleTextures(RenderInterface* render_interface);
+
 	using TextureMap = UnorderedMap< String, SharedPtr<TextureResource> >;
 	TextureMap textures;
 
     using CallbackTextureMap = UnorderedSet< TextureResource* >;
     CallbackTextureMap callback_textures;
+
+	Mutex mutex;
 };
 
 }
@@ -0,0 +1,441 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "TextureLoader.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/Log.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include <algorithm>
+
+namespace Rml {
+namespace Core {
+
+static TextureLoader* texture_loader = nullptr;
+
+static bool loader_enabled = false;
+static TextureCallback loader_decode_callback;
+static TextureDimensionsCallback loader_dimensions_callback;
+
+TextureLoader::TextureLoader()
+{
+	RMLUI_ASSERT(texture_loader == nullptr);
+	texture_loader = this;
+}
+
+TextureLoader::~TextureLoader()
+{
+#ifdef RMLUI_ASYNC_TEXTURE_LOADING
+	StopThreads();
+#endif
+
+	RMLUI_ASSERT(texture_loader == this);
+	texture_loader = nullptr;
+}
+
+void TextureLoader::Initialise()
+{
+	new TextureLoader();
+}
+
+void TextureLoader::Shutdown()
+{
+	delete texture_loader;
+}
+
+bool TextureLoader::IsEnabled()
+{
+	return loader_enabled && texture_loader;
+}
+
+bool TextureLoader::Decode(const String& source, UniquePtr<const byte[]>& data, Vector2i& dimensions)
+{
+	if (!loader_decode_callback)
+		return false;
+
+	return loader_decode_callback(source, data, dimensions);
+}
+
+#ifdef RMLUI_ASYNC_TEXTURE_LOADING
+
+static int loader_num_threads = 2;
+
+void TextureLoader::Enable(const TextureCallback& decode_callback, const TextureDimensionsCallback& dimensions_callback, int num_threads)
+{
+	// The workers call the callbacks, make sure none of them are running while they are replaced.
+	if (texture_loader)
+		texture_loader->StopThreads();
+
+	loader_enabled = static_cast<bool>(decode_callback);
+	loader_decode_callback = decode_callback;
+	loader_dimensions_callback = dimensions_callback;
+	loader_num_threads = Math::Max(num_threads, 1);
+
+	if (texture_loader && loader_enabled && (!texture_loader->dimensions_jobs.empty() || !texture_loader->decode_jobs.empty()))
+		texture_loader->StartThreads();
+}
+
+int TextureLoader::Request(const String& source)
+{
+	RMLUI_ASSERT(IsEnabled());
+
+	int request_id = 0;
+	{
+		std::lock_guard<std::mutex> lock(texture_loader->mutex);
+
+		request_id = texture_loader->next_request_id++;
+		texture_loader->requests[request_id];
+
+		if (loader_dimensions_callback)
+			texture_loader->dimensions_jobs.push_back(Job{ request_id, source });
+		else
+			texture_loader->decode_jobs.push_back(Job{ request_id, source });
+	}
+
+	texture_loader->StartThreads();
+	texture_loader->jobs_condition.notify_one();
+
+	return request_id;
+}
+
+void TextureLoader::Cancel(int request_id)
+{
+	if (!texture_loader)
+		return;
+
+	std::lock_guard<std::mutex> lock(texture_loader->mutex);
+
+	texture_loader->requests.erase(request_id);
+
+	// Remove the job if it has not been started yet, otherwise its result is discarded once completed.
+	for (std::deque<Job>* jobs : { &texture_loader->dimensions_jobs, &texture_loader->decode_jobs })
+	{
+		for (auto it = jobs->begin(); it != jobs->end(); ++it)
+		{
+			if (it->request_id == request_id)
+			{
+				jobs->erase(it);
+				break;
+			}
+		}
+	}
+
+	auto& listeners = texture_loader->listeners;
+	listeners.erase(std::remove_if(listeners.begin(), listeners.end(), [request_id](const Listener& listener) {
+		return listener.request_id == request_id;
+	}), listeners.end());
+}
+
+bool TextureLoader::GetDimensions(int request_id, Vector2i& dimensions)
+{
+	if (!texture_loader)
+		return false;
+
+	std::lock_guard<std::mutex> lock(texture_loader->mutex);
+
+	auto it = texture_loader->requests.find(request_id);
+	if (it == texture_loader->requests.end())
+		return false;
+
+	const RequestState& request = it->second;
+	if (!request.dimensions_read && !(request.decoded && request.success))
+		return false;
+
+	dimensions = request.dimensions;
+	return true;
+}
+
+bool TextureLoader::TakeResult(int request_id, bool& success, UniquePtr<const byte[]>& data, Vector2i& dimensions)
+{
+	if (!texture_loader)
+		return false;
+
+	std::lock_guard<std::mutex> lock(texture_loader->mutex);
+
+	auto it = texture_loader->requests.find(request_id);
+	if (it == texture_loader->requests.end())
+		return false;
+
+	RequestState& request = it->second;
+	if (!request.decoded)
+		return false;
+
+	RMLUI_ASSERT(!request.result_taken);
+
+	success = request.success;
+	data = std::move(request.data);
+	dimensions = request.dimensions;
+
+	// The request is kept until its listeners have been notified.
+	request.result_taken = true;
+	if (request.num_listeners == 0)
+		texture_loader->requests.erase(it);
+
+	return true;
+}
+
+void TextureLoader::AddListener(int request_id, Element* element)
+{
+	if (!texture_loader || !element)
+		return;
+
+	std::lock_guard<std::mutex> lock(texture_loader->mutex);
+
+	auto it = texture_loader->requests.find(request_id);
+	if (it == texture_loader->requests.end())
+		return;
+
+	for (const Listener& listener : texture_loader->listeners)
+	{
+		if (listener.request_id == request_id && listener.element.get() == element)
+			return;
+	}
+
+	texture_loader->listeners.push_back(Listener{ request_id, element->GetContext(), element->GetObserverPtr(), false });
+	it->second.num_listeners += 1;
+}
+
+void TextureLoader::ProcessCompleted(Context* context)
+{
+	if (!texture_loader)
+		return;
+
+	RMLUI_ZoneScoped;
+
+	struct Notification {
+		ObserverPtr<Element> element;
+		bool loaded;
+	};
+	std::vector<Notification> notifications;
+
+	{
+		std::lock_guard<std::mutex> lock(texture_loader->mutex);
+
+		auto& listeners = texture_loader->listeners;
+		for (size_t i = 0; i < listeners.size();)
+		{
+			Listener& listener = listeners[i];
+
+			// Listeners in other contexts are notified during the update of their own context, possibly on another thread.
+			if (listener.context && listener.context != context)
+			{
+				i++;
+				continue;
+			}
+
+			auto it_request = texture_loader->requests.find(listener.request_id);
+			RMLUI_ASSERT(it_request != texture_loader->requests.end());
+			const RequestState& request = it_request->second;
+			if (request.decoded)
+			{
+				const int request_id = listener.request_id;
+				notifications.push_back(Notification{ std::move(listener.element), true });
+				listeners.erase(listeners.begin() + i);
+				texture_loader->RemoveListener(request_id);
+				continue;
+			}
+
+			if (request.dimensions_read && !listener.dimensions_notified)
+			{
+				listener.dimensions_notified = true;
+				notifications.push_back(Notification{ listener.element, false });
+			}
+
+			i++;
+		}
+	}
+
+	// Elements may request or cancel loads, or even be destroyed, while notified, thus we notify them outside the lock.
+	for (Notification& notification : notifications)
+	{
+		if (Element* element = notification.element.get())
+		{
+			element->OnTextureLoad();
+			if (notification.loaded)
+				element->DispatchEvent(EventId::Load, Dictionary());
+		}
+	}
+}
+
+void TextureLoader::RemoveListeners(Context* context)
+{
+	if (!texture_loader)
+		return;
+
+	std::lock_guard<std::mutex> lock(texture_loader->mutex);
+
+	auto& listeners = texture_loader->listeners;
+	for (size_t i = 0; i < listeners.size();)
+	{
+		if (listeners[i].context == context)
+		{
+			const int request_id = listeners[i].request_id;
+			listeners.erase(listeners.begin() + i);
+			texture_loader->RemoveListener(request_id);
+		}
+		else
+			i++;
+	}
+}
+
+void TextureLoader::RemoveListener(int request_id)
+{
+	auto it = requests.find(request_id);
+	if (it == requests.end())
+		return;
+
+	it->second.num_listeners -= 1;
+	if (it->second.result_taken && it->second.num_listeners == 0)
+		requests.erase(it);
+}
+
+void TextureLoader::StartThreads()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (!threads.empty())
+		return;
+
+	quit = false;
+	for (int i = 0; i < loader_num_threads; i++)
+		threads.emplace_back(&TextureLoader::WorkerLoop, this);
+}
+
+void TextureLoader::StopThreads()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+
+	jobs_condition.notify_all();
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	threads.clear();
+}
+
+void TextureLoader::WorkerLoop()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while (true)
+	{
+		jobs_condition.wait(lock, [this] { return quit || !dimensions_jobs.empty() || !decode_jobs.empty(); });
+		if (quit)
+			break;
+
+		const bool read_dimensions = !dimensions_jobs.empty();
+		std::deque<Job>& jobs = (read_dimensions ? dimensions_jobs : decode_jobs);
+
+		Job job = std::move(jobs.front());
+		jobs.pop_front();
+
+		lock.unlock();
+
+		bool success = false;
+		UniquePtr<const byte[]> data;
+		Vector2i dimensions;
+
+		if (read_dimensions)
+			success = loader_dimensions_callback(job.source, dimensions);
+		else
+			success = loader_decode_callback(job.source, data, dimensions) && data;
+
+		lock.lock();
+
+		// The request may have been cancelled meanwhile.
+		auto it = requests.find(job.request_id);
+		if (it == requests.end())
+			continue;
+
+		RequestState& request = it->second;
+
+		if (read_dimensions)
+		{
+			if (success)
+			{
+				request.dimensions = dimensions;
+				request.dimensions_read = true;
+			}
+
+			decode_jobs.push_back(std::move(job));
+			continue;
+		}
+
+		request.decoded = true;
+		request.success = success;
+		if (success)
+		{
+			request.data = std::move(data);
+			request.dimensions = dimensions;
+		}
+	}
+}
+
+#else
+
+void TextureLoader::Enable(const TextureCallback& decode_callback, const TextureDimensionsCallback& /*dimensions_callback*/, int /*num_threads*/)
+{
+	if (decode_callback)
+		Log::Message(Log::LT_WARNING, "Asynchronous texture loading is not available, RmlUi must be built with the ASYNC_TEXTURE_LOADING option.");
+}
+
+int TextureLoader::Request(const String& /*source*/)
+{
+	RMLUI_ERROR;
+	return 0;
+}
+
+void TextureLoader::Cancel(int /*request_id*/)
+{}
+
+bool TextureLoader::GetDimensions(int /*request_id*/, Vector2i& /*dimensions*/)
+{
+	return false;
+}
+
+bool TextureLoader::TakeResult(int /*request_id*/, bool& /*success*/, UniquePtr<const byte[]>& /*data*/, Vector2i& /*dimensions*/)
+{
+	return false;
+}
+
+void TextureLoader::AddListener(int /*request_id*/, Element* /*element*/)
+{}
+
+void TextureLoader::ProcessCompleted(Context* /*context*/)
+{}
+
+void TextureLoader::RemoveListeners(Context* /*context*/)
+{}
+
+#endif
+
+}
+}
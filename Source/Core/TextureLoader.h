@@ -0,0 +1,160 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUICORETEXTURELOADER_H
+#define RMLUICORETEXTURELOADER_H
+
+#include "../../Include/RmlUi/Core/ObserverPtr.h"
+#include "../../Include/RmlUi/Core/Texture.h"
+#include "../../Include/RmlUi/Core/Traits.h"
+#include <deque>
+
+#ifdef RMLUI_ASYNC_TEXTURE_LOADING
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace Rml {
+namespace Core {
+
+class Context;
+
+/**
+	The texture loader decodes textures loaded from a source on a pool of worker threads, so that loading many images
+	does not stall the frame they are first rendered in.
+
+	Textures request to be decoded when first used, and are rendered as nothing until then. The workers first read the
+	dimensions of the requested textures, if the application provides a callback for it, and then decode them. Textures
+	take their decoded data from the loader on their next use, and generate their texture through the render interface.
+	Elements waiting for a texture are notified during the update of their own context, once the dimensions of the
+	texture have been read and once it has been decoded.
+
+	Only available when built with RMLUI_ASYNC_TEXTURE_LOADING, otherwise the loader is never enabled.
+ */
+
+class TextureLoader : public NonCopyMoveable
+{
+public:
+	static void Initialise();
+	static void Shutdown();
+
+	/// Enables asynchronous texture loading, see Rml::Core::EnableAsyncTextureLoading().
+	static void Enable(const TextureCallback& decode_callback, const TextureDimensionsCallback& dimensions_callback, int num_threads);
+	/// Returns true if asynchronous texture loading is enabled.
+	static bool IsEnabled();
+
+	/// Decodes a texture right away on the calling thread using the application's callback.
+	/// @return True if the texture was decoded.
+	static bool Decode(const String& source, UniquePtr<const byte[]>& data, Vector2i& dimensions);
+
+	/// Requests a texture to be decoded on a worker thread.
+	/// @param[in] source The source of the texture.
+	/// @return The identifier of the request.
+	static int Request(const String& source);
+	/// Cancels a request, its listeners are no longer notified.
+	static void Cancel(int request_id);
+
+	/// Returns the dimensions of a requested texture, once they have been read or the texture has been decoded.
+	/// @return True if the dimensions are known.
+	static bool GetDimensions(int request_id, Vector2i& dimensions);
+	/// Takes the result of a request once the texture has been decoded. The request must not be used afterwards.
+	/// @param[out] success True if the texture was decoded successfully.
+	/// @param[out] data The decoded data of the texture.
+	/// @param[out] dimensions The dimensions of the texture.
+	/// @return False if the texture is still being decoded.
+	static bool TakeResult(int request_id, bool& success, UniquePtr<const byte[]>& data, Vector2i& dimensions);
+
+	/// Adds an element to be notified about a request, during the update of the element's context.
+	static void AddListener(int request_id, Element* element);
+	/// Notifies the listeners in the given context about the requests which have been decoded or had their dimensions
+	/// read since. Must be called from the thread updating the context.
+	static void ProcessCompleted(Context* context);
+	/// Removes the listeners in a context, called when the context is destroyed.
+	static void RemoveListeners(Context* context);
+
+private:
+	TextureLoader();
+	~TextureLoader();
+
+#ifdef RMLUI_ASYNC_TEXTURE_LOADING
+	// Starts the worker threads, if they are not already running.
+	void StartThreads();
+	// Stops and joins the worker threads, after they have finished their current jobs.
+	void StopThreads();
+
+	// Reads the dimensions of and decodes requested textures until the threads are stopped.
+	void WorkerLoop();
+
+	// Removes a listener from its request, and forgets the request once it is complete and has no listeners left.
+	void RemoveListener(int request_id);
+
+	struct Job {
+		int request_id;
+		String source;
+	};
+
+	struct RequestState {
+		bool dimensions_read = false;
+		bool decoded = false;
+		bool result_taken = false;
+		bool success = false;
+		UniquePtr<const byte[]> data;
+		Vector2i dimensions;
+		int num_listeners = 0;
+	};
+
+	struct Listener {
+		int request_id;
+		// The context of the element when it started listening, the element is only notified during its update.
+		Context* context;
+		ObserverPtr<Element> element;
+		bool dimensions_notified;
+	};
+
+	// Reading the dimensions is quick, and lets the layout be corrected early, thus those jobs are done first.
+	std::deque<Job> dimensions_jobs;
+	std::deque<Job> decode_jobs;
+
+	UnorderedMap<int, RequestState> requests;
+	int next_request_id = 1;
+
+	std::vector<Listener> listeners;
+
+	std::vector<std::thread> threads;
+	bool quit = false;
+
+	std::mutex mutex;
+	std::condition_variable jobs_condition;
+#endif
+};
+
+}
+}
+
+#endif
@@ -27,7 +27,10 @@
  */
 
 #include "TextureResource.h"
+#include "TextureAtlas.h"
 #include "TextureDatabase.h"
+#include "TextureLoader.h"
+#include "../../Include/RmlUi/Core/Element.h"
 #include "../../Include/RmlUi/Core/Log.h"
 #include "../../Include/RmlUi/Core/RenderInterface.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
@@ -35,23 +38,26 @@
 namespace Rml {
 namespace Core {
 
-TextureResource::TextureResource()
+TextureResource::TextureResource() : last_used_frame(0)
 {
 }
 
 TextureResource::~TextureResource()
 {
+	MutexLock lock(mutex);
 	Reset();
 }
 
 void TextureResource::Set(const String& _source)
 {
+	MutexLock lock(mutex);
 	Reset();
 	source = _source;
 }
 
 void TextureResource::Set(const String& name, const TextureCallback& callback)
 {
+	MutexLock lock(mutex);
 	Reset();
 	source = name;
 	texture_callback = std::make_unique<TextureCallback>(callback);
@@ -60,7 +66,7 @@ void TextureResource::Set(const String& name, const TextureCallback& callback)
 
 void TextureResource::Reset()
 {
-	Release();
+	ReleaseHandles(nullptr);
 
 	if (texture_callback)
 	{
@@ -68,35 +74,174 @@ void TextureResource::Reset()
 		texture_callback.reset();
 	}
 
+	if (atlas_texture)
+	{
+		TextureAtlas::RemoveTexture(this);
+		atlas_texture = false;
+	}
+
+	if (load_request)
+	{
+		TextureLoader::Cancel(load_request);
+		load_request = 0;
+	}
+
+	load_failed = false;
+	evicted = false;
+	loaded_dimensions = Vector2i(0, 0);
+
 	source.clear();
 }
 
+bool TextureResource::Update(const Vector2i& region_offset, const Vector2i& region_dimensions, const byte* source, int source_stride)
+{
+	MutexLock lock(mutex);
+	RMLUI_ASSERTMSG(texture_callback, "Only textures set with a callback function can be updated.");
+
+	bool result = true;
+
+	for (auto it = texture_data.begin(); it != texture_data.end();)
+	{
+		RenderInterface* render_interface = it->first;
+		TextureHandle handle = it->second.first;
+
+		if (!handle || render_interface->UpdateTexture(handle, region_offset, region_dimensions, source, source_stride))
+		{
+			++it;
+			continue;
+		}
+
+		// Not supported by the render interface, release the texture so that it is generated again on next use.
+		render_interface->ReleaseTexture(handle);
+		it = texture_data.erase(it);
+		result = false;
+	}
+
+	return result;
+}
+
 // Returns the resource's underlying texture.
 TextureHandle TextureResource::GetHandle(RenderInterface* render_interface)
 {
+	MutexLock lock(mutex);
+	last_used_frame = TextureDatabase::GetFrame();
+
 	auto texture_iterator = texture_data.find(render_interface);
 	if (texture_iterator == texture_data.end())
 	{
 		Load(render_interface);
 		texture_iterator = texture_data.find(render_interface);
+
+		// The texture is being loaded asynchronously.
+		if (texture_iterator == texture_data.end())
+			return 0;
 	}
 
+	if (atlas_texture)
+		return TextureAtlas::GetHandle(this, render_interface);
+
 	return texture_iterator->second.first;
 }
 
 // Returns the dimensions of the resource's texture.
-const Vector2i& TextureResource::GetDimensions(RenderInterface* render_interface)
+Vector2i TextureResource::GetDimensions(RenderInterface* render_interface)
 {
+	MutexLock lock(mutex);
+
 	auto texture_iterator = texture_data.find(render_interface);
 	if (texture_iterator == texture_data.end())
 	{
 		Load(render_interface);
 		texture_iterator = texture_data.find(render_interface);
+
+		// The texture is being loaded asynchronously, its dimensions are only known once read by the texture loader.
+		if (texture_iterator == texture_data.end())
+		{
+			if (load_request)
+				TextureLoader::GetDimensions(load_request, loaded_dimensions);
+			return loaded_dimensions;
+		}
 	}
 
 	return texture_iterator->second.second;
 }
 
+bool TextureResource::GetAtlasRegion(RenderInterface* render_interface, Vector2f& texcoord_offset, Vector2f& texcoord_scale, int& version, TextureHandle& handle)
+{
+	MutexLock lock(mutex);
+
+	if (!atlas_texture && !TextureAtlas::IsEnabled())
+		return false;
+
+	// Make sure the texture is loaded, so that we know whether it is packed into the atlas.
+	if (texture_data.find(render_interface) == texture_data.end())
+		Load(render_interface);
+
+	if (!atlas_texture)
+		return false;
+
+	last_used_frame = TextureDatabase::GetFrame();
+
+	return TextureAtlas::GetRegion(this, render_interface, texcoord_offset, texcoord_scale, version, handle);
+}
+
+bool TextureResource::IsLoading(RenderInterface* render_interface)
+{
+	MutexLock lock(mutex);
+
+	if (texture_data.find(render_interface) != texture_data.end())
+		return false;
+
+	Load(render_interface);
+
+	return load_request != 0 && texture_data.find(render_interface) == texture_data.end();
+}
+
+void TextureResource::AddLoadListener(Element* element)
+{
+	MutexLock lock(mutex);
+
+	if (!load_request || !element)
+		return;
+
+	TextureLoader::AddListener(load_request, element);
+}
+
+size_t TextureResource::GetMemorySize(RenderInterface* render_interface) const
+{
+	MutexLock lock(mutex);
+
+	size_t memory_size = 0;
+
+	// Textures packed into the atlas hold no handles of their own, their memory is accounted for by the atlas pages.
+	for (const auto& interface_data_pair : texture_data)
+	{
+		const TextureData& data = interface_data_pair.second;
+		if (data.first && (!render_interface || interface_data_pair.first == render_interface))
+			memory_size += size_t(data.second.x) * size_t(data.second.y) * 4;
+	}
+
+	return memory_size;
+}
+
+Vector2i TextureResource::GetResidentDimensions() const
+{
+	MutexLock lock(mutex);
+
+	for (const auto& interface_data_pair : texture_data)
+	{
+		if (interface_data_pair.second.first)
+			return interface_data_pair.second.second;
+	}
+
+	return Vector2i(0, 0);
+}
+
+int TextureResource::GetLastUsedFrame() const
+{
+	return last_used_frame;
+}
+
 // Returns the resource's source.
 const String& TextureResource::GetSource() const
 {
@@ -105,6 +250,19 @@ const String& TextureResource::GetSource() const
 
 // Releases the texture's handle.
 void TextureResource::Release(RenderInterface* render_interface)
+{
+	MutexLock lock(mutex);
+	ReleaseHandles(render_interface);
+}
+
+void TextureResource::Evict(RenderInterface* render_interface)
+{
+	MutexLock lock(mutex);
+	ReleaseHandles(render_interface);
+	evicted = true;
+}
+
+void TextureResource::ReleaseHandles(RenderInterface* render_interface)
 {
 	if (!render_interface)
 	{
@@ -135,6 +293,8 @@ bool TextureResource::Load(RenderInterface* render_interface)
 {
 	RMLUI_ZoneScoped;
 
+	last_used_frame = TextureDatabase::GetFrame();
+
 	// Generate the texture from the callback function if we have one.
 	if (texture_callback)
 	{
@@ -167,6 +327,60 @@ bool TextureResource::Load(RenderInterface* render_interface)
 		return success;
 	}
 
+	// Textures packed into the atlas have their handles provided by the atlas pages.
+	if (atlas_texture)
+	{
+		texture_data[render_interface] = TextureData(0, atlas_dimensions);
+		return true;
+	}
+
+	// If asynchronous loading is enabled, request the texture to be decoded on a worker thread, and generate it once
+	// decoded. Until then, no texture data is stored for the render interface.
+	if (TextureLoader::IsEnabled() && !load_failed && !evicted)
+	{
+		if (!load_request)
+		{
+			load_request = TextureLoader::Request(source);
+			return false;
+		}
+
+		bool success = false;
+		UniquePtr<const byte[]> data;
+		Vector2i dimensions;
+
+		if (!TextureLoader::TakeResult(load_request, success, data, dimensions))
+			return false;
+
+		load_request = 0;
+
+		// The decoded data is only kept until the texture is generated, other render interfaces load it again.
+		if (success && Upload(render_interface, std::move(data), dimensions))
+			return true;
+
+		load_failed = true;
+	}
+	// Textures released to stay within the memory budget are decoded right away, so that they don't disappear while loading.
+	else if (TextureLoader::IsEnabled() && evicted)
+	{
+		Vector2i dimensions;
+		UniquePtr<const byte[]> data;
+
+		evicted = false;
+
+		if (TextureLoader::Decode(source, data, dimensions) && data && Upload(render_interface, std::move(data), dimensions))
+			return true;
+	}
+	// If the texture atlas is enabled, decode the texture through the application so that small textures can be packed
+	// into the atlas. Otherwise, or if the texture could not be decoded, load it through the render interface.
+	else if (TextureAtlas::IsEnabled())
+	{
+		Vector2i dimensions;
+		UniquePtr<const byte[]> data;
+
+		if (TextureAtlas::Decode(source, data, dimensions) && data && Upload(render_interface, std::move(data), dimensions))
+			return true;
+	}
+
 	// No callback function, load the texture through the render interface.
 	TextureHandle handle;
 	Vector2i dimensions;
@@ -182,5 +396,24 @@ bool TextureResource::Load(RenderInterface* render_interface)
 	return true;
 }
 
+bool TextureResource::Upload(RenderInterface* render_interface, UniquePtr<const byte[]> data, const Vector2i& dimensions)
+{
+	if (TextureAtlas::IsEnabled() && TextureAtlas::CanAddTexture(dimensions))
+	{
+		TextureAtlas::AddTexture(this, std::move(data), dimensions);
+		atlas_texture = true;
+		atlas_dimensions = dimensions;
+		texture_data[render_interface] = TextureData(0, dimensions);
+		return true;
+	}
+
+	TextureHandle handle;
+	if (!render_interface->GenerateTexture(handle, data.get(), dimensions))
+		return false;
+
+	texture_data[render_interface] = TextureData(handle, dimensions);
+	return true;
+}
+
 }
 }
@@ -29,8 +29,11 @@
 #ifndef RMLUICORETEXTURERESOURCE_H
 #define RMLUICORETEXTURERESOURCE_H
 
+#include "../../Include/RmlUi/Core/ObserverPtr.h"
 #include "../../Include/RmlUi/Core/Traits.h"
 #include "../../Include/RmlUi/Core/Texture.h"
+#include "Mutex.h"
+#include <atomic>
 
 namespace Rml {
 namespace Core {
@@ -39,6 +42,9 @@ namespace Core {
 	A texture resource stores application-generated texture data (handle and dimensions) for each
 	unique render interface that needs to render the data. It is used through a Texture object.
 
+	Resources are shared between all contexts using the same texture, thus their state is guarded by a mutex when
+	contexts may be updated concurrently.
+
 	@author Peter Curry
  */
 
@@ -56,22 +62,51 @@ public:
 	/// Texture loading is delayed until the texture is accessed by a specific render interface.
 	void Set(const String& name, const TextureCallback& callback);
 
+	/// Updates a region of the texture in every render interface it has been generated for, releasing the texture from
+	/// those which do not support updating textures.
+	/// @return True if the texture kept its handles, false if any of them were released.
+	bool Update(const Vector2i& region_offset, const Vector2i& region_dimensions, const byte* source, int source_stride);
+
 	/// Returns the resource's underlying texture handle.
 	TextureHandle GetHandle(RenderInterface* render_interface);
 	/// Returns the dimensions of the resource's texture.
-	const Vector2i& GetDimensions(RenderInterface* render_interface);
+	Vector2i GetDimensions(RenderInterface* render_interface);
+	/// Returns the region of the texture on its texture atlas page and the handle of the page, if it is packed into the atlas.
+	bool GetAtlasRegion(RenderInterface* render_interface, Vector2f& texcoord_offset, Vector2f& texcoord_scale, int& version, TextureHandle& handle);
+
+	/// Returns true if the texture is being loaded asynchronously for the render interface.
+	bool IsLoading(RenderInterface* render_interface);
+	/// Adds an element to be notified once the dimensions of the texture have been read and once the texture has been
+	/// loaded asynchronously, if it is being loaded.
+	void AddLoadListener(Element* element);
+
+	/// Returns the memory used by the resource's texture handles, assuming four bytes per pixel.
+	/// @param[in] render_interface The render interface to count the handles of, or nullptr for all render interfaces.
+	size_t GetMemorySize(RenderInterface* render_interface = nullptr) const;
+	/// Returns the dimensions of the first of the resource's texture handles, or zero if it holds none.
+	Vector2i GetResidentDimensions() const;
+	/// Returns the frame the texture was last used in, see TextureDatabase::GetFrame().
+	int GetLastUsedFrame() const;
 
 	/// Returns the resource's source.
 	const String& GetSource() const;
 
 	/// Releases the texture's handle.
 	void Release(RenderInterface* render_interface = nullptr);
+	/// Releases the texture's handle to stay within the texture memory budget. The texture was likely visible before,
+	/// thus it is loaded again right away when next used, rather than being loaded asynchronously.
+	void Evict(RenderInterface* render_interface);
 
 private:
+	/// Clears any existing data. The following functions expect the mutex to be locked.
 	void Reset();
+	/// Releases the texture's handle for the render interface, or for all render interfaces if nullptr.
+	void ReleaseHandles(RenderInterface* render_interface);
 
 	/// Attempts to load the texture from the source, or the callback function if set.
 	bool Load(RenderInterface* render_interface);
+	/// Generates the texture from decoded data, or packs it into the texture atlas if enabled and small enough.
+	bool Upload(RenderInterface* render_interface, UniquePtr<const byte[]> data, const Vector2i& dimensions);
 
 	String source;
 
@@ -80,6 +115,29 @@ private:
 	TextureDataMap texture_data;
 
 	UniquePtr<TextureCallback> texture_callback;
+
+	// The frame the texture was last used in, for releasing the least recently used textures when over the memory budget.
+	// Read by the texture database while other contexts may be using the texture.
+	std::atomic<int> last_used_frame;
+	// Set if the texture has been released to stay within the memory budget, until it is loaded again.
+	bool evicted = false;
+
+	// True if the texture has been packed into the texture atlas, its handles then refer to the atlas pages.
+	bool atlas_texture = false;
+	Vector2i atlas_dimensions;
+
+	// The identifier of the pending asynchronous load request, or zero if none. The request is owned by the texture
+	// loader, which alone is accessed by its worker threads.
+	int load_request = 0;
+	// Set if the texture could not be decoded asynchronously, it is then loaded through the render interface instead.
+	bool load_failed = false;
+	// The dimensions of the texture while it is being loaded, once they have been read by the texture loader.
+	Vector2i loaded_dimensions;
+
+	// Guards all of the above, except for the source which is only set before the resource is shared. Locked before the
+	// texture atlas and the texture database. The database only locks resources in turn while rendering or releasing
+	// textures, when no context is being updated.
+	mutable Mutex mutex;
 };
 
 }
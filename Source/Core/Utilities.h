@@ -40,6 +40,19 @@ inline void HashCombine(std::size_t& seed, const T& v)
 	seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
 
+// Hashes the data with the 64-bit FNV-1a function, continuing from the given hash. Unlike std::hash, the result is the
+// same across runs and standard library implementations, thus it can be stored.
+inline uint64_t HashFNV1a(const void* data, size_t size, uint64_t hash = 0xcbf29ce484222325ull)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= (uint64_t)bytes[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
 }
 }
 }
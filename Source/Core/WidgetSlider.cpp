@@ -161,6 +161,9 @@ void WidgetSlider::Update()
 			}
 		}
 	}
+
+	if (arrow_timers[0] > 0 || arrow_timers[1] > 0)
+		DirtyOwnerUpdate();
 }
 
 // Sets the position of the bar.
@@ -445,6 +448,9 @@ void WidgetSlider::ProcessEvent(Event& event)
 			last_update_time = Clock::GetElapsedTime();
 			SetBarPosition(OnLineIncrement());
 		}
+
+		if (arrow_timers[0] > 0 || arrow_timers[1] > 0)
+			DirtyOwnerUpdate();
 	}
 	else if (event == EventId::Mouseup ||
 			 event == EventId::Mouseout)
@@ -456,6 +462,13 @@ void WidgetSlider::ProcessEvent(Event& event)
 	}
 }
 
+// The arrow repeats are advanced during the update of the scrolled element, which owns the scrollbar element.
+void WidgetSlider::DirtyOwnerUpdate()
+{
+	if (Element* owner = parent->GetParentNode())
+		owner->DirtyUpdate();
+}
+
 void WidgetSlider::PositionBar()
 {
 	const Vector2f& track_dimensions = track->GetBox().GetSize();
@@ -118,6 +118,7 @@ protected:
 
 private:
 	void PositionBar();
+	void DirtyOwnerUpdate();
 
 	Element* parent;
 
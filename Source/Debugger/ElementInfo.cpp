@@ -118,6 +118,9 @@ ElementInfo::ElementInfo(const Core::String& tag) : Core::ElementDocument(tag)
 	title_dirty = true;
 	previous_update_time = 0.0;
 
+	// The source element is refreshed periodically during the update.
+	EnableContinuousUpdate(true);
+
 	RMLUI_ASSERT(TestPrettyFormat("0.15", "0.15"));
 	RMLUI_ASSERT(TestPrettyFormat("0.150", "0.15"));
 	RMLUI_ASSERT(TestPrettyFormat("1.15", "1.15"));
@@ -181,6 +181,7 @@ void ElementLog::AddLogMessage(Core::Log::Type type, const Core::String& message
 
 	// Force a refresh of the RML.
 	dirty_logs = true;
+	DirtyUpdate();
 }
 
 void ElementLog::OnUpdate()
@@ -255,6 +256,7 @@ void ElementLog::ProcessEvent(Core::Event& event)
 					}
 				}
 				dirty_logs = true;
+				DirtyUpdate();
 			}
 			else
 			{
@@ -268,6 +270,7 @@ void ElementLog::ProcessEvent(Core::Event& event)
 						else
 							event.GetTargetElement()->SetInnerRML("Off");
 						dirty_logs = true;
+						DirtyUpdate();
 					}
 				}
 			}
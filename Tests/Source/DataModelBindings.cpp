@@ -0,0 +1,132 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#include "TestsShell.h"
+
+using namespace Rml::Core;
+
+static const char* document_rml = R"(
+<rml>
+<body data-model="test" style="font-family: Delicious;">
+	<div id="section">
+		<p id="greeting">Hello {{name}}!</p>
+		<ul id="list"><li data-for="item : items" data-attr-title="item.name">{{item.name}}</li></ul>
+	</div>
+	<div id="destination"/>
+	<div id="box" data-style-width="width" data-style-color="colour"/>
+</body>
+</rml>
+)";
+
+// Returns the text of the repeated elements in a list, excluding the template.
+static String GetItems(Element* list)
+{
+	String result;
+	for (int i = 0; i < list->GetNumChildren(); i++)
+	{
+		Element* child = list->GetChild(i);
+		if (child->HasAttribute("data-for"))
+			continue;
+		result += child->GetInnerRML() + ";";
+	}
+	return result;
+}
+
+int main()
+{
+	Context* context = TestsShell::Initialise();
+
+	DataModel* model = context->CreateDataModel("test");
+	model->SetValue("name", String("World"));
+	model->SetArraySize("items", 2);
+	model->SetArrayValue("items", 0, "name", String("a"));
+	model->SetArrayValue("items", 1, "name", String("b"));
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	TESTS_CHECK(document != nullptr);
+	if (!document)
+		return TestsShell::Shutdown();
+
+	document->Show();
+	context->Update();
+
+	Element* greeting = document->GetElementById("greeting");
+	Element* list = document->GetElementById("list");
+	TESTS_CHECK(greeting->GetInnerRML() == "Hello World!");
+	TESTS_CHECK(GetItems(list) == "a;b;");
+
+	model->SetValue("name", String("there"));
+	context->Update();
+	TESTS_CHECK(greeting->GetInnerRML() == "Hello there!");
+
+	// Moving bound elements keeps their bindings, and repeated elements are not repeated again.
+	Element* section = document->GetElementById("section");
+	ElementPtr section_ptr = section->GetParentNode()->RemoveChild(section);
+	document->GetElementById("destination")->AppendChild(std::move(section_ptr));
+	context->Update();
+	TESTS_CHECK(GetItems(list) == "a;b;");
+
+	model->SetValue("name", String("again"));
+	model->SetArrayValue("items", 1, "name", String("c"));
+	context->Update();
+	TESTS_CHECK(greeting->GetInnerRML() == "Hello again!");
+	TESTS_CHECK(GetItems(list) == "a;c;");
+
+	// Values can be set through handles, which avoid looking up their names.
+	DataModel::ValueHandle first_name = model->GetArrayHandle("items", 0, "name");
+	model->SetValue(first_name, String("d"));
+	context->Update();
+	TESTS_CHECK(GetItems(list) == "d;c;");
+	TESTS_CHECK(*model->GetValue("items[0].name") == Variant(String("d")));
+
+	model->SetArraySize("items", 3);
+	model->SetArrayValue("items", 2, "name", String("e"));
+	context->Update();
+	TESTS_CHECK(GetItems(list) == "d;c;e;");
+
+	model->SetArraySize("items", 1);
+	context->Update();
+	TESTS_CHECK(GetItems(list) == "d;");
+
+	// Numbers and colours are applied to properties without parsing them.
+	Element* box = document->GetElementById("box");
+	model->SetValue("width", 100);
+	model->SetValue("colour", Colourb(255, 0, 0));
+	context->Update();
+	const Property* width = box->GetProperty(PropertyId::Width);
+	TESTS_CHECK(width && width->unit == Property::PX && width->Get<float>() == 100.f);
+	TESTS_CHECK(box->GetProperty<Colourb>("color") == Colourb(255, 0, 0));
+
+	model->SetValue("width", String("50%"));
+	context->Update();
+	width = box->GetProperty(PropertyId::Width);
+	TESTS_CHECK(width && width->unit == Property::PERCENT && width->Get<float>() == 50.f);
+
+	return TestsShell::Shutdown();
+}
@@ -0,0 +1,110 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#include "TestsShell.h"
+
+using namespace Rml::Core;
+
+// Records the order in which the listeners process an event.
+class OrderListener : public EventListener
+{
+public:
+	OrderListener(String& log, const String& name) : log(log), name(name) {}
+
+	void ProcessEvent(Event& event) override
+	{
+		log += name;
+
+		switch (event.GetPhase())
+		{
+		case EventPhase::Capture: log += "(capture) "; break;
+		case EventPhase::Target: log += "(target) "; break;
+		case EventPhase::Bubble: log += "(bubble) "; break;
+		default: log += "(none) "; break;
+		}
+	}
+
+private:
+	String& log;
+	String name;
+};
+
+int main()
+{
+	Context* context = TestsShell::Initialise();
+
+	ElementDocument* document = context->LoadDocumentFromMemory("<rml><body><div id='parent'><div id='target'/></div></body></rml>");
+	TESTS_CHECK(document != nullptr);
+	if (!document)
+		return TestsShell::Shutdown();
+
+	document->Show();
+	context->Update();
+
+	Element* parent = document->GetElementById("parent");
+	Element* target = document->GetElementById("target");
+
+	String log;
+	OrderListener parent_bubble(log, "parent-bubble"), parent_capture(log, "parent-capture");
+	OrderListener target_1(log, "target-1"), target_2(log, "target-2"), target_3(log, "target-3"), target_4(log, "target-4");
+
+	parent->AddEventListener("custom", &parent_bubble, false);
+	parent->AddEventListener("custom", &parent_capture, true);
+
+	// At the target, the listeners attached to the bubble phase run first, then those attached to the capture phase,
+	// each in the order they were attached.
+	target->AddEventListener("custom", &target_1, true);
+	target->AddEventListener("custom", &target_2, false);
+	target->AddEventListener("custom", &target_3, true);
+	target->AddEventListener("custom", &target_4, false);
+
+	target->DispatchEvent("custom", Dictionary(), false, true);
+	printf("%s\n", log.c_str());
+	TESTS_CHECK(log == "parent-capture(capture) target-2(target) target-4(target) target-1(target) target-3(target) parent-bubble(bubble) ");
+
+	// Events which do not bubble still run the capture and target listeners.
+	log.clear();
+	target->DispatchEvent("custom", Dictionary(), false, false);
+	printf("%s\n", log.c_str());
+	TESTS_CHECK(log == "parent-capture(capture) target-2(target) target-4(target) target-1(target) target-3(target) ");
+
+	// The order is the same for events dispatched a second time, when the dispatch buffers are reused.
+	log.clear();
+	target->DispatchEvent("custom", Dictionary(), false, true);
+	TESTS_CHECK(log == "parent-capture(capture) target-2(target) target-4(target) target-1(target) target-3(target) parent-bubble(bubble) ");
+
+	parent->RemoveEventListener("custom", &parent_bubble, false);
+	parent->RemoveEventListener("custom", &parent_capture, true);
+	target->RemoveEventListener("custom", &target_1, true);
+	target->RemoveEventListener("custom", &target_2, false);
+	target->RemoveEventListener("custom", &target_3, true);
+	target->RemoveEventListener("custom", &target_4, false);
+
+	return TestsShell::Shutdown();
+}
@@ -0,0 +1,101 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "TestsShell.h"
+#include <chrono>
+
+using namespace Rml::Core;
+
+// Counts the textures generated, and the memory they use assuming four bytes per pixel.
+class TextureMemoryInterface : public TestsRenderInterface
+{
+public:
+	bool GenerateTexture(TextureHandle& texture_handle, const byte* source, const Vector2i& source_dimensions) override
+	{
+		num_generated_textures += 1;
+		generated_texture_bytes += size_t(source_dimensions.x) * size_t(source_dimensions.y) * 4;
+		return TestsRenderInterface::GenerateTexture(texture_handle, source, source_dimensions);
+	}
+
+	int num_generated_textures = 0;
+	size_t generated_texture_bytes = 0;
+};
+
+// Shows every font size from 8px to 48px, as plain text and with font effects, and reports the texture memory and time
+// used to generate the text. Build with and without the SCALED_FONT_GLYPHS option to compare the two modes.
+int main()
+{
+	TestsShell::Initialise();
+
+	TextureMemoryInterface render_interface;
+	Context* context = CreateContext("sweep", Vector2i(1024, 768), &render_interface);
+
+	String body;
+	for (int size = 8; size <= 48; size++)
+	{
+		body += CreateString(128, "<p style='font-size: %dpx;'>The quick brown fox jumps over the lazy dog 0123456789</p>", size);
+		body += CreateString(128, "<p class='effects' style='font-size: %dpx;'>Glowing outlined text</p>", size);
+	}
+
+	// Font effects are only instanced from style sheets. The font family is set on the document itself, so that it is
+	// also inherited by the text of the style element.
+	const String rml = "<rml><head><style>"
+		"html { font-family: Delicious; }"
+		"body { display: block; width: 1000px; }"
+		"p { display: block; }"
+		".effects { font-effect: glow(2px 4px 2px 3px #f00), outline(2px blue); }"
+		"</style></head><body>" + body + "</body></rml>";
+
+	const auto start_time = std::chrono::steady_clock::now();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(rml);
+	TESTS_CHECK(document != nullptr);
+	if (document)
+		document->Show();
+
+	context->Update();
+	context->Render();
+
+	const double duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+#ifdef RMLUI_SCALED_FONT_GLYPHS
+	const char* mode = "scaled glyphs";
+#else
+	const char* mode = "glyphs per size";
+#endif
+
+	printf("Font sizes 8px to 48px with %s: %.1f MB in %d textures, generated in %.0f ms.\n", mode,
+		double(render_interface.generated_texture_bytes) / (1024.0 * 1024.0), render_interface.num_generated_textures, duration);
+
+	TESTS_CHECK(render_interface.num_generated_textures > 0);
+	TESTS_CHECK(render_interface.num_geometry_rendered > 0);
+
+	RemoveContext("sweep");
+
+	return TestsShell::Shutdown();
+}
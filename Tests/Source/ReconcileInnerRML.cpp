@@ -0,0 +1,128 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "TestsShell.h"
+#include <RmlUi/Core/ObserverPtr.h>
+
+using namespace Rml::Core;
+
+using ObserverList = std::vector< ObserverPtr<Element> >;
+
+// Returns observers of the children of an element, they are reset when an element is destroyed.
+static ObserverList GetChildren(Element* element)
+{
+	ObserverList result;
+	for (int i = 0; i < element->GetNumChildren(); i++)
+		result.push_back(element->GetChild(i)->GetObserverPtr());
+	return result;
+}
+
+// Returns one character for each child of an element: the index of the old child it still is, or '-' for new elements.
+static String GetSurvivors(Element* element, const ObserverList& old_children)
+{
+	String result;
+	for (int i = 0; i < element->GetNumChildren(); i++)
+	{
+		Element* child = element->GetChild(i);
+
+		char survivor = '-';
+		for (size_t j = 0; j < old_children.size(); j++)
+		{
+			if (old_children[j].get() == child)
+				survivor = char('0' + j);
+		}
+		result += survivor;
+	}
+	return result;
+}
+
+// Reconciles the content of an element, and returns which of its previous children survived in which order.
+static String Reconcile(Context* context, Element* element, const String& rml)
+{
+	const ObserverList old_children = GetChildren(element);
+	element->ReconcileInnerRML(rml);
+	context->Update();
+
+	TESTS_CHECK(element->GetInnerRML() == rml);
+
+	return GetSurvivors(element, old_children);
+}
+
+int main()
+{
+	Context* context = TestsShell::Initialise();
+
+	ElementDocument* document = context->LoadDocumentFromMemory("<rml><body style='font-family: Delicious;'><div id='list'/></body></rml>");
+	TESTS_CHECK(document != nullptr);
+	if (!document)
+		return TestsShell::Shutdown();
+
+	document->Show();
+	context->Update();
+
+	Element* list = document->GetElementById("list");
+
+	TESTS_CHECK(Reconcile(context, list, "<p key=\"a\">A</p><p key=\"b\">B</p><p key=\"c\">C</p>") == "---");
+
+	// Unchanged content keeps all elements.
+	TESTS_CHECK(Reconcile(context, list, "<p key=\"a\">A</p><p key=\"b\">B</p><p key=\"c\">C</p>") == "012");
+
+	// Keyed elements are moved, and have their attributes and text patched in place.
+	TESTS_CHECK(Reconcile(context, list, "<p key=\"c\">C2</p><p class=\"x\" key=\"a\">A</p><p key=\"b\">B</p>") == "201");
+	TESTS_CHECK(list->GetChild(1)->IsClassSet("x"));
+	TESTS_CHECK(Reconcile(context, list, "<p key=\"c\">C2</p><p key=\"a\">A</p><p key=\"b\">B</p>") == "012");
+	TESTS_CHECK(!list->GetChild(1)->IsClassSet("x"));
+
+	// Keyed elements missing from the new content are removed, new keys are adopted.
+	TESTS_CHECK(Reconcile(context, list, "<p key=\"b\">B</p><p key=\"d\">D</p>") == "2-");
+
+	// Elements sharing a key are matched in order, and never against unkeyed elements.
+	TESTS_CHECK(Reconcile(context, list, "<p key=\"d\">1</p><p key=\"d\">2</p><p>u</p>") == "1--");
+	TESTS_CHECK(Reconcile(context, list, "<p>u</p><p key=\"d\">1</p><p key=\"d\">2</p>") == "201");
+	TESTS_CHECK(Reconcile(context, list, "<p key=\"d\">1</p><p>v</p>") == "10");
+
+	// Unkeyed elements are matched by position. A candidate with a different tag is used up and replaced, thus a
+	// following element of the matching tag is not kept either.
+	TESTS_CHECK(Reconcile(context, list, "<div>x</div><p>y</p>") == "--");
+	TESTS_CHECK(Reconcile(context, list, "<p>y</p>") == "-");
+	TESTS_CHECK(Reconcile(context, list, "<p>y</p><span>z</span>") == "0-");
+
+	// Changed event attributes can't be patched, such elements are replaced.
+	TESTS_CHECK(Reconcile(context, list, "<p onclick=\"a\">y</p><span>z</span>") == "-1");
+	TESTS_CHECK(Reconcile(context, list, "<p onclick=\"a\">y</p><span>z</span>") == "01");
+	TESTS_CHECK(Reconcile(context, list, "<p onclick=\"b\">y</p><span>z</span>") == "-1");
+
+	// Nested children are reconciled as well.
+	Reconcile(context, list, "<div><p key=\"a\">A</p><p key=\"b\">B</p></div>");
+	Element* nested = list->GetChild(0);
+	const ObserverList nested_children = GetChildren(nested);
+	TESTS_CHECK(Reconcile(context, list, "<div><p key=\"b\">B</p><p key=\"a\">A2</p></div>") == "0");
+	TESTS_CHECK(GetSurvivors(nested, nested_children) == "10");
+
+	return TestsShell::Shutdown();
+}
@@ -0,0 +1,303 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "TestsShell.h"
+#include <RmlUi/Core/RenderCommandBuffer.h>
+#include <atomic>
+#include <set>
+#include <thread>
+
+using namespace Rml::Core;
+
+// Checks that it is only called from the render thread, and that geometry only uses textures which are alive.
+class RenderThreadInterface : public RenderInterface
+{
+public:
+	void RenderGeometry(Vertex* /*vertices*/, int /*num_vertices*/, int* /*indices*/, int /*num_indices*/, TextureHandle texture, const Vector2f& /*translation*/) override
+	{
+		CheckThread();
+		CheckTexture(texture);
+		num_geometry_rendered += 1;
+		if (texture)
+			num_textured_geometry_rendered += 1;
+		if (texture && texture == loaded_texture)
+			num_image_geometry_rendered += 1;
+	}
+
+	void EnableScissorRegion(bool /*enable*/) override { CheckThread(); }
+	void SetScissorRegion(int /*x*/, int /*y*/, int /*width*/, int /*height*/) override { CheckThread(); }
+
+	bool LoadTexture(TextureHandle& texture_handle, Vector2i& texture_dimensions, const String& /*source*/) override
+	{
+		CheckThread();
+		texture_handle = ++last_texture;
+		texture_dimensions = Vector2i(32, 32);
+		loaded_texture = texture_handle;
+		textures.insert(texture_handle);
+		num_loaded_textures += 1;
+		return true;
+	}
+
+	bool GenerateTexture(TextureHandle& texture_handle, const byte* /*source*/, const Vector2i& /*source_dimensions*/) override
+	{
+		CheckThread();
+		texture_handle = ++last_texture;
+		textures.insert(texture_handle);
+		num_generated_textures += 1;
+		return true;
+	}
+
+	bool UpdateTexture(TextureHandle texture_handle, const Vector2i& /*region_offset*/, const Vector2i& /*region_dimensions*/, const byte* /*source*/, int /*source_stride*/) override
+	{
+		CheckThread();
+		CheckTexture(texture_handle);
+		if (!support_updates)
+			return false;
+
+		num_updated_textures += 1;
+		return true;
+	}
+
+	void ReleaseTexture(TextureHandle texture_handle) override
+	{
+		CheckThread();
+		if (textures.erase(texture_handle) == 0)
+			num_invalid_textures += 1;
+	}
+
+	std::thread::id render_thread;
+	bool support_updates = true;
+	std::set< TextureHandle > textures;
+	TextureHandle last_texture = 0;
+	TextureHandle loaded_texture = 0;
+
+	int num_geometry_rendered = 0;
+	int num_textured_geometry_rendered = 0;
+	int num_image_geometry_rendered = 0;
+	int num_loaded_textures = 0;
+	int num_generated_textures = 0;
+	int num_updated_textures = 0;
+	int num_wrong_thread_calls = 0;
+	int num_invalid_textures = 0;
+
+private:
+	void CheckThread()
+	{
+		if (std::this_thread::get_id() != render_thread)
+			num_wrong_thread_calls += 1;
+	}
+
+	void CheckTexture(TextureHandle texture)
+	{
+		if (texture && textures.find(texture) == textures.end())
+			num_invalid_textures += 1;
+	}
+};
+
+// Renders a context through a command buffer, replaying its commands on a separate render thread. The new text should
+// contain glyphs not encountered before, so that the font textures are updated.
+static void RenderThreaded(bool support_updates, const String& new_text)
+{
+	RenderThreadInterface render_interface;
+	render_interface.support_updates = support_updates;
+
+	// The dimensions of images are read up front, so that loading them can be recorded as well.
+	RenderCommandBuffer* command_buffer = new RenderCommandBuffer(&render_interface, [](const String& /*source*/, Vector2i& dimensions) {
+		dimensions = Vector2i(32, 32);
+		return true;
+	});
+
+	// The render thread replays the submitted commands, and finally destroys the command buffer.
+	std::atomic<bool> quit(false);
+	std::thread render_thread([&] {
+		while (!quit)
+		{
+			if (!command_buffer->Replay())
+				std::this_thread::yield();
+		}
+
+		command_buffer->Replay();
+		delete command_buffer;
+	});
+	render_interface.render_thread = render_thread.get_id();
+
+	Context* context = CreateContext("threaded", Vector2i(1024, 768), command_buffer);
+
+	ElementDocument* document = context->LoadDocumentFromMemory("<rml><body style='font-family: Delicious;'><p id='text'>Hello</p><img id='image' src='image.png'/></body></rml>");
+	TESTS_CHECK(document != nullptr);
+	if (document)
+	{
+		document->Show();
+
+		for (int i = 0; i < 10; i++)
+		{
+			// New glyphs update the font textures while their older versions may still be used by commands being replayed.
+			if (i == 5)
+				document->GetElementById("text")->SetInnerRML(new_text);
+
+			context->Update();
+			context->Render();
+			command_buffer->Submit();
+		}
+
+		TESTS_CHECK(document->GetElementById("image")->GetClientWidth() == 32.f);
+	}
+
+	RemoveContext("threaded");
+	context = nullptr;
+	command_buffer->Submit();
+
+	quit = true;
+	render_thread.join();
+
+	printf("Rendered %d geometries, %d with a texture and %d with the image. Loaded %d, generated %d and updated %d textures.\n",
+		render_interface.num_geometry_rendered, render_interface.num_textured_geometry_rendered, render_interface.num_image_geometry_rendered,
+		render_interface.num_loaded_textures, render_interface.num_generated_textures, render_interface.num_updated_textures);
+
+	TESTS_CHECK(render_interface.num_wrong_thread_calls == 0);
+	TESTS_CHECK(render_interface.num_invalid_textures == 0);
+	TESTS_CHECK(render_interface.num_generated_textures > 0);
+	TESTS_CHECK(render_interface.num_textured_geometry_rendered > 0);
+	TESTS_CHECK(render_interface.num_image_geometry_rendered == 10);
+	TESTS_CHECK(render_interface.textures.empty());
+
+	// When updates fail, all textures are released once and then generated or loaded again.
+	if (support_updates)
+	{
+		TESTS_CHECK(render_interface.num_updated_textures > 0);
+		TESTS_CHECK(render_interface.num_loaded_textures == 1);
+	}
+	else
+	{
+		TESTS_CHECK(render_interface.num_updated_textures == 0);
+		TESTS_CHECK(render_interface.num_loaded_textures == 2);
+	}
+}
+
+#ifdef RMLUI_THREAD_SAFE_CONTEXTS
+// Updates two contexts sharing a command buffer from separate threads at the same time, while their commands are replayed
+// on the render thread. Each update re-colours text, which releases its compiled geometry during the update, and adds new
+// glyphs, which update the font textures.
+static void UpdateConcurrently()
+{
+	RenderThreadInterface render_interface;
+	render_interface.support_updates = true;
+
+	RenderCommandBuffer* command_buffer = new RenderCommandBuffer(&render_interface, [](const String& /*source*/, Vector2i& dimensions) {
+		dimensions = Vector2i(32, 32);
+		return true;
+	});
+
+	std::atomic<bool> quit(false);
+	std::thread render_thread([&] {
+		while (!quit)
+		{
+			if (!command_buffer->Replay())
+				std::this_thread::yield();
+		}
+
+		command_buffer->Replay();
+		delete command_buffer;
+	});
+	render_interface.render_thread = render_thread.get_id();
+
+	constexpr int num_contexts = 2;
+	Context* contexts[num_contexts] = {};
+	Element* texts[num_contexts] = {};
+	Element* colours[num_contexts] = {};
+
+	for (int i = 0; i < num_contexts; i++)
+	{
+		contexts[i] = CreateContext(CreateString(32, "concurrent%d", i), Vector2i(1024, 768), command_buffer);
+		ElementDocument* document = contexts[i]->LoadDocumentFromMemory("<rml><body style='font-family: Delicious;'><p id='text'>Hello</p><p id='colour'>Hello</p></body></rml>");
+		TESTS_CHECK(document != nullptr);
+		if (document)
+		{
+			document->Show();
+			texts[i] = document->GetElementById("text");
+			colours[i] = document->GetElementById("colour");
+		}
+	}
+
+	for (int frame = 0; frame < 10; frame++)
+	{
+		std::thread update_threads[num_contexts];
+		for (int i = 0; i < num_contexts; i++)
+		{
+			update_threads[i] = std::thread([&, i] {
+				// Latin-1 letters not used before in this frame or by the other context.
+				String text;
+				for (int j = 0; j < 3; j++)
+					text += StringUtilities::ToUTF8(Character(0xC0 + (frame * num_contexts + i) * 3 + j));
+
+				if (texts[i] && colours[i])
+				{
+					texts[i]->SetInnerRML(text);
+					colours[i]->SetProperty("color", frame % 2 == 0 ? "#ff0000" : "#00ff00");
+				}
+				contexts[i]->Update();
+			});
+		}
+
+		for (std::thread& update_thread : update_threads)
+			update_thread.join();
+
+		for (Context* context : contexts)
+			context->Render();
+		command_buffer->Submit();
+	}
+
+	for (int i = 0; i < num_contexts; i++)
+		RemoveContext(CreateString(32, "concurrent%d", i));
+	command_buffer->Submit();
+
+	quit = true;
+	render_thread.join();
+
+	printf("Updated %d contexts concurrently. Rendered %d geometries, generated %d and updated %d textures.\n",
+		num_contexts, render_interface.num_geometry_rendered, render_interface.num_generated_textures, render_interface.num_updated_textures);
+
+	TESTS_CHECK(render_interface.num_wrong_thread_calls == 0);
+	TESTS_CHECK(render_interface.num_invalid_textures == 0);
+	TESTS_CHECK(render_interface.num_updated_textures > 0);
+	TESTS_CHECK(render_interface.textures.empty());
+}
+#endif
+
+int main()
+{
+	TestsShell::Initialise();
+
+	RenderThreaded(true, "Hello, wörld!");
+	RenderThreaded(false, "Ça va très bien, señor.");
+#ifdef RMLUI_THREAD_SAFE_CONTEXTS
+	UpdateConcurrently();
+#endif
+
+	return TestsShell::Shutdown();
+}
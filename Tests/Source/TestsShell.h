@@ -0,0 +1,135 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#ifndef RMLUITESTSSHELL_H
+#define RMLUITESTSSHELL_H
+
+#include <RmlUi/Core.h>
+#include <RmlUi/Controls.h>
+#include <cstdio>
+
+/**
+	Interfaces and helpers shared by the tests. The tests run without a window: the system interface advances time only
+	when told to, and the render interface accepts all geometry and textures without rendering them.
+ */
+
+class TestsSystemInterface : public Rml::Core::SystemInterface
+{
+public:
+	double GetElapsedTime() override { return elapsed_time; }
+
+	bool LogMessage(Rml::Core::Log::Type type, const Rml::Core::String& message) override
+	{
+		if (type <= Rml::Core::Log::LT_WARNING)
+			printf("%s\n", message.c_str());
+		return true;
+	}
+
+	void AdvanceTime(double seconds) { elapsed_time += seconds; }
+
+private:
+	double elapsed_time = 0.0;
+};
+
+class TestsRenderInterface : public Rml::Core::RenderInterface
+{
+public:
+	void RenderGeometry(Rml::Core::Vertex* /*vertices*/, int /*num_vertices*/, int* /*indices*/, int /*num_indices*/, Rml::Core::TextureHandle /*texture*/, const Rml::Core::Vector2f& /*translation*/) override
+	{
+		num_geometry_rendered += 1;
+	}
+
+	void EnableScissorRegion(bool /*enable*/) override {}
+	void SetScissorRegion(int /*x*/, int /*y*/, int /*width*/, int /*height*/) override {}
+
+	bool LoadTexture(Rml::Core::TextureHandle& texture_handle, Rml::Core::Vector2i& texture_dimensions, const Rml::Core::String& /*source*/) override
+	{
+		texture_handle = ++num_textures;
+		texture_dimensions = Rml::Core::Vector2i(16, 16);
+		return true;
+	}
+
+	bool GenerateTexture(Rml::Core::TextureHandle& texture_handle, const Rml::Core::byte* /*source*/, const Rml::Core::Vector2i& /*source_dimensions*/) override
+	{
+		texture_handle = ++num_textures;
+		return true;
+	}
+
+	int num_geometry_rendered = 0;
+	int num_textures = 0;
+};
+
+namespace TestsShell {
+
+static TestsSystemInterface system_interface;
+static TestsRenderInterface render_interface;
+static int num_failed_checks = 0;
+
+// Initialises RmlUi with the tests interfaces and creates a context.
+inline Rml::Core::Context* Initialise(const Rml::Core::Vector2i& dimensions = Rml::Core::Vector2i(1024, 768))
+{
+	Rml::Core::SetSystemInterface(&system_interface);
+	Rml::Core::SetRenderInterface(&render_interface);
+	Rml::Core::Initialise();
+	Rml::Controls::Initialise();
+
+	Rml::Core::LoadFontFace("Samples/assets/Delicious-Roman.otf");
+
+	return Rml::Core::CreateContext("main", dimensions);
+}
+
+// Shuts down RmlUi, and returns the exit code of the test.
+inline int Shutdown()
+{
+	Rml::Core::Shutdown();
+
+	if (num_failed_checks > 0)
+	{
+		printf("%d check(s) failed.\n", num_failed_checks);
+		return 1;
+	}
+
+	printf("All checks passed.\n");
+	return 0;
+}
+
+inline void Check(bool condition, const char* expression, const char* file, int line)
+{
+	if (!condition)
+	{
+		printf("%s(%d): Check failed: %s\n", file, line, expression);
+		num_failed_checks += 1;
+	}
+}
+
+}
+
+#define TESTS_CHECK(expression) TestsShell::Check((expression), #expression, __FILE__, __LINE__)
+
+#endif